@@ -0,0 +1,63 @@
+#ifndef IO_H
+#define IO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Entrada de arquivos com chamadas POSIX (mmap, pthreads) e
+ * descompressão de gzip/xz/bzip2.
+ *
+ * Este módulo não inclui utils.h: o timer_t de utils.h colide com o tipo
+ * de mesmo nome dos cabeçalhos POSIX. Por isso a interface usa apenas
+ * tipos padrão do C99.
+ */
+
+/* Arquivo mapeado em memória (somente leitura) */
+typedef struct {
+    const char *data;      // Conteúdo do arquivo
+    size_t size;           // Tamanho em bytes
+    void *address;         // Endereço do mapeamento (NULL para arquivo vazio)
+} io_mapping_t;
+
+/* Tipo de um caminho, obtido sem abrir o arquivo (abrir um FIFO consumiria a entrada) */
+typedef enum {
+    IO_PATH_MISSING,
+    IO_PATH_REGULAR,
+    IO_PATH_OTHER              // FIFO, dispositivo, /dev/stdin...
+} io_path_kind_t;
+
+io_path_kind_t io_path_kind(const char *filename);
+bool io_stdin_is_terminal(void);
+
+/* Mapeia um arquivo regular inteiro; false se não existe, não é regular ou mmap falha */
+bool io_map_file(const char *filename, io_mapping_t *mapping);
+void io_unmap(io_mapping_t *mapping);
+
+/* Executa task(context, i) para i em [0, count), cada índice em uma thread */
+void io_parallel_for(size_t count, void (*task)(void *context, size_t index), void *context);
+/* Número de processadores disponíveis (ao menos 1) */
+size_t io_cpu_count(void);
+
+/* Formatos de compressão reconhecidos pelos bytes mágicos */
+typedef enum {
+    IO_COMPRESSION_NONE,
+    IO_COMPRESSION_GZIP,
+    IO_COMPRESSION_XZ,
+    IO_COMPRESSION_BZIP2
+} io_compression_t;
+
+/* Descompressor em thread própria (opaco) */
+typedef struct io_decoder io_decoder_t;
+
+io_compression_t io_detect_compression(const char *filename);
+const char* io_compression_to_string(io_compression_t compression);
+
+/* Inicia a descompressão em segundo plano; NULL se o arquivo não abre */
+io_decoder_t* io_decoder_open(const char *filename, io_compression_t compression);
+/* Lê bytes já descompactados (bloqueia até haver dados); 0 = fim. source é o io_decoder_t */
+size_t io_decoder_read(void *source, char *dest, size_t size);
+/* Encerra a thread e libera o descompressor; false se houve erro de descompressão */
+bool io_decoder_close(io_decoder_t *decoder);
+
+#endif /* IO_H */
@@ -27,12 +27,28 @@ typedef struct {
     char error_message[256];   // Mensagem de erro detalhada
 } parser_info_t;
 
+/* Funções para estatísticas de parsing */
+typedef struct {
+    size_t total_lines;        // Total de linhas processadas
+    size_t comment_lines;      // Linhas de comentário
+    size_t empty_lines;        // Linhas vazias
+    size_t clause_lines;       // Linhas de cláusulas
+    size_t problem_lines;      // Linhas de definição do problema
+    size_t bytes;              // Bytes da entrada
+    double parse_time;         // Tempo de parsing
+    double throughput;         // Vazão em MB/s (bytes / parse_time)
+} parse_stats_t;
+
 /* Estrutura principal do parser */
 typedef struct {
     parser_info_t info;
+    parse_stats_t stats;
     cnf_formula_t *formula;
+    clause_normalizer_t normalizer; // Marcas para duplicatas e tautologias
     bool strict_mode;          // Se deve ser rigoroso com o formato
+    bool sort_literals;        // Ordenar os literais de cada cláusula por variável
     bool verbose;              // Se deve imprimir informações detalhadas
+    size_t parse_threads;      // Threads para arquivos mapeados (1 = serial, 0 = automático)
 } cnf_parser_t;
 
 /* Funções principais do parser */
@@ -43,6 +59,7 @@ void parser_destroy(cnf_parser_t *parser);
 parse_result_t parser_parse_file(cnf_parser_t *parser, const char *filename);
 parse_result_t parser_parse_string(cnf_parser_t *parser, const char *content);
 parse_result_t parser_parse_stream(cnf_parser_t *parser, FILE *stream);
+parse_result_t parser_parse_buffer(cnf_parser_t *parser, const char *data, size_t size);
 
 /* Funções de validação */
 bool parser_validate_file(const char *filename, parser_info_t *info);
@@ -55,7 +72,8 @@ void parser_reset(cnf_parser_t *parser);
 
 /* Funções de parsing de baixo nível */
 parse_result_t parse_problem_line(const char *line, int *num_vars, int *num_clauses);
-parse_result_t parse_clause_line(const char *line, clause_t *clause, int max_variables);
+parse_result_t parse_clause_line(const char *line, literal_vector_t *clause,
+                                 clause_normalizer_t *normalizer);
 parse_result_t parse_comment_line(const char *line);
 
 /* Funções auxiliares */
@@ -64,16 +82,6 @@ bool is_problem_line(const char *line);
 bool is_clause_line(const char *line);
 bool is_empty_line(const char *line);
 
-/* Funções para estatísticas de parsing */
-typedef struct {
-    size_t total_lines;        // Total de linhas processadas
-    size_t comment_lines;      // Linhas de comentário
-    size_t empty_lines;        // Linhas vazias
-    size_t clause_lines;       // Linhas de cláusulas
-    size_t problem_lines;      // Linhas de definição do problema
-    double parse_time;         // Tempo de parsing
-} parse_stats_t;
-
 void parse_stats_init(parse_stats_t *stats);
 void parse_stats_print(const parse_stats_t *stats);
 
@@ -99,6 +107,9 @@ void parser_set_config(cnf_parser_t *parser, const parser_config_t *config);
 bool parser_write_cnf_file(const cnf_formula_t *cnf, const char *filename);
 bool parser_write_cnf_stream(const cnf_formula_t *cnf, FILE *stream);
 
+/* Formato binário (carregado automaticamente por parser_parse_file) */
+bool parser_write_binary(const cnf_formula_t *cnf, const char *filename, bool compact);
+
 /* Macro para verificar resultado do parsing */
 #define CHECK_PARSE_RESULT(result, parser) \
     do { \
@@ -0,0 +1,20 @@
+#ifndef PREPROCESS_H
+#define PREPROCESS_H
+
+#include "solver.h"
+
+/*
+ * Simplificações que reescrevem a base de cláusulas no nível 0 usando
+ * listas de ocorrências próprias. Enquanto rodam, as listas de observação
+ * e os contadores do solver ficam desatualizados: quem as chama
+ * (simplify_clauses) reconstrói essas estruturas em seguida.
+ */
+
+/* Equivalências, subsunção, bloqueadas e BVE, com orçamentos em literais
+   visitados; false se a fórmula é insatisfatível */
+bool simplify_occurrences(dpll_solver_t *solver, uint64_t subsume_budget, uint64_t elim_budget);
+
+/* Completa o modelo com as variáveis eliminadas (após uma resposta SAT) */
+void extend_model(dpll_solver_t *solver);
+
+#endif /* PREPROCESS_H */
@@ -20,22 +20,70 @@ typedef enum {
     DECISION_FIRST_UNASSIGNED = 0,  /* Primeira variável não atribuída */
     DECISION_MOST_FREQUENT = 1,     /* Variável mais frequente */
     DECISION_JEROSLOW_WANG = 2,     /* Heurística Jeroslow-Wang */
-    DECISION_RANDOM = 3             /* Aleatória */
+    DECISION_RANDOM = 3,            /* Aleatória */
+    DECISION_VSIDS = 4              /* VSIDS: atividade em conflitos recentes */
 } decision_strategy_t;
 
+/* Modos de busca */
+typedef enum {
+    SEARCH_DPLL = 0,                /* DPLL com backtracking cronológico */
+    SEARCH_CDCL = 1                 /* Aprendizado de cláusulas com backjumping */
+} search_mode_t;
+
+/* Políticas de reinicialização */
+typedef enum {
+    RESTART_FIXED = 0,              /* A cada restart_threshold conflitos */
+    RESTART_LUBY = 1,               /* Sequência de Luby com unidade luby_unit */
+    RESTART_GEOMETRIC = 2,          /* Intervalo multiplicado por restart_factor */
+    RESTART_GLUCOSE = 3             /* Médias móveis do LBD (rápida x lenta), com bloqueio */
+} restart_policy_t;
+
 /* Configuração do solver */
 typedef struct {
     decision_strategy_t decision_strategy;  /* Estratégia de decisão */
+    search_mode_t search_mode;             /* Modo de busca (DPLL ou CDCL) */
     bool enable_pure_literal;              /* Ativar eliminação de literais puros */
     bool enable_unit_propagation;          /* Ativar propagação unitária */
     bool enable_preprocessing;             /* Ativar pré-processamento */
+    bool enable_elimination;               /* Eliminação de variáveis (BVE) no pré e no inprocessamento */
+    bool enable_subsumption;               /* Subsunção e resolução auto-subsumida no pré e no inprocessamento */
+    bool enable_probing;                   /* Sondagem de literais falhos no pré e no inprocessamento */
+    bool enable_equivalences;              /* Substituição de literais equivalentes no pré e no inprocessamento */
+    bool enable_blocked;                   /* Eliminação de cláusulas bloqueadas no pré e no inprocessamento */
+    bool enable_vivification;              /* Vivificação das cláusulas no inprocessamento */
+    bool enable_inprocessing;              /* Simplificações periódicas durante a busca CDCL */
     bool enable_restarts;                 /* Ativar reinicializações */
     size_t max_decisions;                 /* Máximo de decisões (0 = sem limite) */
     double timeout_seconds;               /* Timeout em segundos (0 = sem timeout) */
     size_t restart_threshold;             /* Threshold para reinicialização */
+    restart_policy_t restart_policy;      /* Política de reinicialização */
+    double restart_factor;                /* Razão do intervalo na política geométrica */
+    size_t luby_unit;                     /* Conflitos por termo da sequência de Luby */
+    double glucose_margin;                /* Glucose: reinicia se média rápida > margem * lenta */
+    double glucose_block_margin;          /* Glucose: bloqueia se pilha > margem * média */
+    double vsids_decay;                   /* Decaimento das atividades VSIDS (0 < d < 1) */
+    double garbage_fraction;              /* Fração desperdiçada da arena que dispara a coleta */
+    size_t reduce_interval;               /* Conflitos até a primeira redução das aprendidas */
+    size_t reduce_increment;              /* Acréscimo do intervalo a cada redução */
+    uint32_t core_lbd;                    /* LBD máximo da camada core */
+    uint32_t tier2_lbd;                   /* LBD máximo da camada intermediária */
+    double clause_decay;                  /* Decaimento da atividade das aprendidas (0 < d < 1) */
+    size_t inprocess_interval;            /* Conflitos até a primeira execução de cada técnica */
+    double inprocess_growth;              /* Razão do crescimento dos intervalos do inprocessamento */
+    double probe_effort;                  /* Fração dos ticks da busca gasta na sondagem */
+    double subsume_effort;                /* Fração dos ticks da busca gasta na subsunção */
+    double elim_effort;                   /* Fração dos ticks da busca gasta na eliminação */
+    double vivify_effort;                 /* Fração dos ticks da busca gasta na vivificação */
     bool verbose;                         /* Modo verboso */
 } solver_config_t;
 
+/* Agenda de uma técnica de inprocessamento */
+typedef struct {
+    uint64_t next;                    /* Conflitos em que a técnica volta a rodar */
+    uint64_t interval;                /* Intervalo atual, multiplicado por inprocess_growth */
+    uint64_t ticks;                   /* stats.ticks ao fim da execução anterior */
+} inprocess_schedule_t;
+
 /* Estado do solver DPLL */
 typedef struct {
     cnf_formula_t *formula;           /* Fórmula a ser resolvida */
@@ -45,12 +93,62 @@ typedef struct {
     
     /* Cache e estruturas auxiliares */
     bool *pure_literals;              /* Cache de literais puros */
-    clause_t **unit_clauses;          /* Lista de cláusulas unitárias */
+    clause_ref_t *unit_clauses;       /* Lista de cláusulas unitárias */
     size_t unit_clauses_count;        /* Número de cláusulas unitárias */
     
+    /* Propagação com dois literais observados */
+    watch_list_t *watches;            /* Listas de observação indexadas por literal_index() */
+    size_t propagation_head;          /* Próxima entrada da pilha a ser propagada */
+    clause_ref_t conflict_clause;     /* Conflito encontrado pela última propagação */
+    
+    /* Contadores incrementais de satisfação */
+    variable_t assigned_count;        /* Variáveis atribuídas */
+    bool track_satisfaction;          /* Mantém clause->true_literals das originais (DPLL, JW, frequência) */
+    size_t original_clauses;          /* Cláusulas originais monitoradas */
+    
+    /* Scores incrementais por literal, somados sobre cláusulas não satisfeitas */
+    double *jw_scores;                /* Jeroslow-Wang: soma de 2^-|C| por literal_index() */
+    uint32_t *literal_frequency;      /* Número de cláusulas não satisfeitas com o literal */
+    
+    /* Aprendizado de cláusulas (CDCL) */
+    size_t *trail_position;           /* Índice de cada variável na pilha de atribuições */
+    bool *seen;                       /* Marcas temporárias da análise de conflitos */
+    literal_t *learnt_buffer;         /* Cláusula aprendida em construção */
+    uint32_t *level_stamp;            /* Marca por nível de decisão, para calcular o LBD */
+    uint32_t stamp_counter;           /* Marca atual de level_stamp */
+    
+    /* Base de cláusulas aprendidas */
+    double clause_activity_increment; /* Incremento da atividade das aprendidas */
+    uint64_t next_reduce;             /* Conflitos em que ocorre a próxima redução */
+    size_t reduce_interval;           /* Intervalo atual entre reduções */
+    
+    /* Inprocessamento: uma agenda por técnica */
+    inprocess_schedule_t probe_schedule;
+    inprocess_schedule_t subsume_schedule;
+    inprocess_schedule_t elim_schedule;
+    inprocess_schedule_t vivify_schedule;
+    size_t vivify_position;           /* Próxima cláusula candidata à vivificação */
+    
+    /* Heurística VSIDS */
+    double *activity;                 /* Atividade de cada variável */
+    double activity_increment;        /* Incremento atual (cresce a cada conflito) */
+    var_heap_t *order_heap;           /* Variáveis candidatas por atividade */
+    
+    /* Remoção de cláusulas */
+    size_t simplified_trail_size;     /* Atribuições de nível 0 na última remoção de satisfeitas */
+    
+    /* Variáveis eliminadas e reconstrução do modelo */
+    bool *eliminated;                 /* Variáveis fora da fórmula: a busca não as decide */
+    variable_t eliminated_count;      /* Número de variáveis eliminadas */
+    literal_vector_t reconstruction;  /* Cláusulas removidas (testemunha primeiro), cada uma seguida do tamanho */
+    
     /* Estado interno */
     bool formula_modified;            /* Se a fórmula foi modificada */
     size_t conflicts_since_restart;   /* Conflitos desde último restart */
+    size_t restart_limit;             /* Conflitos até o próximo restart (Luby, geométrica) */
+    double lbd_ema_fast;              /* Glucose: média móvel rápida do LBD dos conflitos */
+    double lbd_ema_slow;              /* Glucose: média móvel lenta do LBD dos conflitos */
+    double trail_ema;                 /* Glucose: média móvel do tamanho da pilha nos conflitos */
     timer_t total_timer;              /* Timer total */
 } dpll_solver_t;
 
@@ -72,8 +170,11 @@ solver_result_t solver_solve(dpll_solver_t *solver);
 /* Função principal do DPLL */
 solver_result_t dpll_algorithm(dpll_solver_t *solver);
 
-/* Propagação de unidades */
-solver_result_t unit_propagation(dpll_solver_t *solver);
+/* Função principal do CDCL (aprendizado de cláusulas e backjumping) */
+solver_result_t cdcl_algorithm(dpll_solver_t *solver);
+
+/* Propagação de unidades: devolve a cláusula em conflito ou CLAUSE_REF_UNDEF */
+clause_ref_t unit_propagation(dpll_solver_t *solver);
 
 /* Eliminação de literais puros */
 bool pure_literal_elimination(dpll_solver_t *solver);
@@ -84,20 +185,48 @@ var_assignment_t choose_decision_value(dpll_solver_t *solver, variable_t var);
 
 /* Backtracking */
 bool backtrack(dpll_solver_t *solver);
+void backjump(dpll_solver_t *solver, size_t level);
 void print_assignment_stack(const dpll_solver_t *solver);
 
+/* ========== Aprendizado de Cláusulas ========== */
+
+/* Análise de conflito pelo primeiro UIP; devolve o tamanho da cláusula em learnt_buffer */
+size_t analyze_conflict(dpll_solver_t *solver, clause_ref_t conflict, size_t *backjump_level);
+
+/* Adiciona a cláusula aprendida e atribui seu literal assertivo */
+bool learn_clause(dpll_solver_t *solver, const literal_t *literals, size_t size, uint32_t lbd);
+
+/* Descarta metade da camada local das aprendidas, protegendo as razões */
+void reduce_learnt_clauses(dpll_solver_t *solver);
+
+/* Encurta cláusulas propagando a negação de seus literais, com orçamento em ticks */
+void vivify_clauses(dpll_solver_t *solver, uint64_t budget);
+
+/* Roda, no nível 0, as técnicas de inprocessamento cujo intervalo venceu */
+bool inprocess_formula(dpll_solver_t *solver);
+
 /* ========== Estratégias de Decisão ========== */
 
 variable_t decision_first_unassigned(const dpll_solver_t *solver);
 variable_t decision_most_frequent(const dpll_solver_t *solver);
 variable_t decision_jeroslow_wang(const dpll_solver_t *solver);
 variable_t decision_random(const dpll_solver_t *solver);
+variable_t decision_vsids(dpll_solver_t *solver);
 
 /* ========== Pré-processamento ========== */
 
 bool preprocess_formula(dpll_solver_t *solver);
 bool remove_satisfied_clauses(dpll_solver_t *solver);
-bool simplify_clauses(dpll_solver_t *solver);
+void collect_garbage(dpll_solver_t *solver);
+
+/* Orçamento de simplify_clauses limitado apenas pelos limites fixos de cada técnica */
+#define SIMPLIFY_UNLIMITED UINT64_MAX
+
+/* Subsunção e eliminação (equivalências, bloqueadas, BVE); orçamento zero pula a técnica */
+bool simplify_clauses(dpll_solver_t *solver, uint64_t subsume_budget, uint64_t elim_budget);
+
+/* Literais falhos e resolventes hiper-binários, com orçamento em ticks de propagação */
+bool probe_literals(dpll_solver_t *solver, uint64_t budget);
 bool eliminate_pure_literals_preprocessing(dpll_solver_t *solver);
 
 /* ========== Análise e Detecção ========== */
@@ -108,10 +237,10 @@ bool find_unit_clauses(dpll_solver_t *solver);
 /* Detectar literais puros */
 bool find_pure_literals(dpll_solver_t *solver);
 
-/* Detectar conflitos */
+/* Detectar conflitos (O(1): reportado pela propagação) */
 bool has_conflict(const dpll_solver_t *solver);
 
-/* Verificar se fórmula está satisfeita */
+/* Verificar se fórmula está satisfeita (O(1): contadores incrementais) */
 bool is_formula_satisfied(const dpll_solver_t *solver);
 
 /* ========== Configuração e Estado ========== */
@@ -148,10 +277,15 @@ double calculate_jeroslow_wang_score(const dpll_solver_t *solver, variable_t var
 /* Calcular frequência de literal */
 size_t calculate_literal_frequency(const dpll_solver_t *solver, literal_t literal);
 
+/* VSIDS: aumentar atividade de uma variável e decair todas após um conflito */
+void vsids_bump_variable(dpll_solver_t *solver, variable_t var);
+void vsids_decay_activities(dpll_solver_t *solver);
+
 /* ========== Reinicializações ========== */
 
 bool should_restart(const dpll_solver_t *solver);
 void perform_restart(dpll_solver_t *solver);
+void restart_on_conflict(dpll_solver_t *solver, uint32_t lbd);
 
 /* ========== Validação ========== */
 
@@ -175,6 +309,9 @@ bool validate_partial_assignment(const dpll_solver_t *solver);
 #define IS_VARIABLE_ASSIGNED(solver, var) \
     ((solver)->formula->assignment[var] != VAR_UNASSIGNED)
 
+#define IS_VARIABLE_ELIMINATED(solver, var) \
+    ((solver)->eliminated[var])
+
 #define IS_LITERAL_SATISFIED(solver, lit) \
     ((lit > 0 && (solver)->formula->assignment[lit] == VAR_TRUE) || \
      (lit < 0 && (solver)->formula->assignment[-lit] == VAR_FALSE))
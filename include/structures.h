@@ -29,36 +29,98 @@ typedef struct {
     bool is_positive;       // true se literal positivo, false se negativo
 } literal_struct_t;
 
-/* Estrutura para uma cláusula */
+/* Cláusula armazenada na arena: cabeçalho seguido dos literais, sem ponteiros */
 typedef struct {
-    literal_t *literals;    // Array de literais na cláusula
+    uint32_t size;              // Número de literais
+    uint32_t learnt : 1;        // Cláusula aprendida em conflito (redundante)
+    uint32_t deleted : 1;       // Removida; o espaço volta na próxima coleta
+    uint32_t relocated : 1;     // Já copiada pela coleta; literals[0] guarda a nova referência
+    uint32_t used : 1;          // Aprendida: participou de um conflito desde a última redução
+    uint32_t tier : 2;          // Aprendida: camada na base de aprendidas (clause_tier_t)
+    uint32_t lbd : 26;          // Aprendida: níveis de decisão distintos (glue)
+    uint32_t true_literals;     // Original: literais verdadeiros na atribuição atual (mantido pelo solver)
+    float activity;             // Aprendida: atividade em conflitos recentes
+    literal_t literals[];       // Literais, logo após o cabeçalho
+} clause_t;
+
+/* Camadas das cláusulas aprendidas, da mais à menos protegida */
+typedef enum {
+    CLAUSE_TIER_CORE = 0,       // LBD muito baixo: mantida para sempre
+    CLAUSE_TIER_MID = 1,        // LBD intermediário (tier2): mantida enquanto for usada
+    CLAUSE_TIER_LOCAL = 2       // Demais: metade descartada a cada redução
+} clause_tier_t;
+
+/* Referência a uma cláusula (deslocamento, em palavras de 32 bits, na arena) */
+typedef uint32_t clause_ref_t;
+#define CLAUSE_REF_UNDEF UINT32_MAX
+
+/* Arena de cláusulas: um único bloco contíguo de palavras de 32 bits */
+typedef struct {
+    uint32_t *memory;      // Cabeçalhos e literais, em ordem de alocação
+    size_t size;           // Palavras em uso
+    size_t capacity;       // Palavras alocadas
+    size_t wasted;         // Palavras ocupadas por cláusulas removidas
+} clause_arena_t;
+
+#define CLAUSE_HEADER_WORDS (sizeof(clause_t) / sizeof(uint32_t))
+
+/* Vetor de literais reutilizável (montagem de cláusulas antes da arena) */
+typedef struct {
+    literal_t *literals;   // Literais
     size_t size;           // Número de literais
     size_t capacity;       // Capacidade alocada
-    bool is_satisfied;     // Cache: se a cláusula está satisfeita
-    bool is_unit;          // Cache: se é uma cláusula unitária
-    literal_t unit_literal; // Se unitária, qual é o literal unitário
-} clause_t;
+} literal_vector_t;
 
-/* Lista de cláusulas */
+/* Lista de referências a cláusulas (sem cópia das cláusulas) */
 typedef struct {
-    clause_t *clauses;     // Array de cláusulas
-    size_t count;          // Número de cláusulas
+    clause_ref_t *refs;    // Referências
+    size_t count;          // Número de referências
     size_t capacity;       // Capacidade alocada
-} clause_list_t;
+} clause_ref_list_t;
+
+/* Entrada de uma lista de observação (two-watched literals) */
+typedef struct {
+    clause_ref_t clause;   // Cláusula que observa o literal
+    literal_t blocker;     // Outro literal da cláusula: se verdadeiro, a cláusula está satisfeita
+} watcher_t;
+
+/* Lista de observação de um literal */
+typedef struct {
+    watcher_t *watchers;   // Cláusulas que observam o literal
+    size_t size;           // Número de entradas
+    size_t capacity;       // Capacidade alocada
+} watch_list_t;
+
+/*
+ * Normalizador de cláusulas: uma marca por literal, compartilhada entre
+ * todas as cláusulas de uma leitura. Cada cláusula usa um novo valor de
+ * carimbo, então as marcas nunca precisam ser limpas entre cláusulas.
+ */
+typedef struct {
+    uint32_t *marks;            // Carimbo por literal, índice 2 * var + (lit < 0)
+    uint32_t stamp;             // Carimbo da cláusula corrente
+    variable_t num_variables;
+    bool sort_literals;         // Ordenar os literais por variável
+} clause_normalizer_t;
 
 /* Estrutura principal da fórmula CNF */
 typedef struct {
-    clause_list_t clauses;      // Lista de todas as cláusulas
+    clause_arena_t arena;       // Armazenamento de todas as cláusulas
+    clause_ref_list_t clauses;  // Referências das cláusulas, em ordem de inserção
     variable_t num_variables;   // Número total de variáveis
     var_assignment_t *assignment; // Array de atribuições de variáveis [1..num_variables]
     
     /* Estatísticas e cache */
     size_t satisfied_clauses;   // Número de cláusulas satisfeitas
+    size_t learnt_count;        // Quantas das cláusulas são aprendidas
     bool *variable_used;        // Quais variáveis são usadas na fórmula
     
-    /* Para otimizações */
-    clause_list_t **positive_occurrences; // Cláusulas onde cada variável aparece positiva
-    clause_list_t **negative_occurrences; // Cláusulas onde cada variável aparece negativa
+    /* Listas de ocorrências em formato CSR (cláusulas não aprendidas):
+       as cláusulas com x estão em positive_occurrences[positive_offsets[x] .. positive_offsets[x+1]) */
+    size_t *positive_offsets;            // Início da lista de cada variável [1..num_variables+1]
+    clause_ref_t *positive_occurrences;  // Cláusulas onde cada variável aparece positiva
+    size_t *negative_offsets;            // Idem para a polaridade negativa
+    clause_ref_t *negative_occurrences;  // Cláusulas onde cada variável aparece negativa
 } cnf_formula_t;
 
 /* Estrutura para o estado do solver (pilha de decisões) */
@@ -67,6 +129,7 @@ typedef struct {
     var_assignment_t value;     // Valor atribuído
     size_t decision_level;      // Nível de decisão
     bool is_decision;          // true se foi uma decisão, false se propagação
+    clause_ref_t reason;        // Cláusula que forçou a propagação (CLAUSE_REF_UNDEF se nenhuma)
 } assignment_entry_t;
 
 typedef struct {
@@ -76,6 +139,16 @@ typedef struct {
     size_t decision_level;     // Nível atual de decisão
 } assignment_stack_t;
 
+/* Heap binário indexado de variáveis, ordenado por score (máximo no topo) */
+typedef struct {
+    variable_t *heap;          // Variáveis em ordem de heap
+    size_t size;               // Número de variáveis no heap
+    size_t *positions;         // Posição de cada variável no heap (VAR_HEAP_ABSENT se fora)
+    const double *scores;      // Score de cada variável (pertence ao dono do heap)
+} var_heap_t;
+
+#define VAR_HEAP_ABSENT SIZE_MAX
+
 /* Funções para manipulação de literais */
 static inline literal_t make_literal(variable_t var, bool positive) {
     return positive ? var : -var;
@@ -93,38 +166,99 @@ static inline literal_t literal_negate(literal_t lit) {
     return -lit;
 }
 
+/* Índice denso de um literal: x -> 2x, ¬x -> 2x+1 */
+static inline size_t literal_index(literal_t lit) {
+    return lit > 0 ? 2 * (size_t)lit : 2 * (size_t)(-lit) + 1;
+}
+
+/* Valor de um literal sob uma atribuição */
+static inline var_assignment_t literal_value(const var_assignment_t *assignment, literal_t lit) {
+    var_assignment_t value = assignment[literal_variable(lit)];
+    return lit > 0 ? value : (var_assignment_t)(-value);
+}
+
 /* Funções para manipulação de cláusulas */
-clause_t* clause_create(size_t initial_capacity);
-void clause_destroy(clause_t *clause);
-bool clause_add_literal(clause_t *clause, literal_t literal);
 bool clause_is_satisfied(const clause_t *clause, const var_assignment_t *assignment);
 bool clause_is_unit(const clause_t *clause, const var_assignment_t *assignment, literal_t *unit_literal);
 bool clause_is_conflicting(const clause_t *clause, const var_assignment_t *assignment);
-bool clause_is_tautology(const clause_t *clause);
-clause_t* clause_copy(const clause_t *clause);
 
-/* Funções para lista de cláusulas */
-clause_list_t* clause_list_create(size_t initial_capacity);
-void clause_list_destroy(clause_list_t *list);
-/* Libera apenas o conteúdo interno (literals/array), sem dar free no próprio list */
-void clause_list_dispose_contents(clause_list_t *list);
-bool clause_list_add(clause_list_t *list, clause_t *clause);
-void clause_list_clear(clause_list_t *list);
+/* Funções para vetores de literais */
+bool literal_vector_push(literal_vector_t *vector, literal_t literal);
+bool literal_vector_contains(const literal_vector_t *vector, literal_t literal);
+void literal_vector_dispose(literal_vector_t *vector);
+
+/* Normalização de cláusulas (duplicatas e tautologias em tempo linear) */
+bool clause_normalizer_init(clause_normalizer_t *normalizer, variable_t num_variables,
+                            bool sort_literals);
+void clause_normalizer_dispose(clause_normalizer_t *normalizer);
+bool clause_normalize(clause_normalizer_t *normalizer, literal_t *literals, size_t *size);
+bool clause_is_normalized(clause_normalizer_t *normalizer, const literal_t *literals, size_t size);
+
+/* Funções para a arena de cláusulas */
+clause_ref_t clause_arena_alloc(clause_arena_t *arena, const literal_t *literals, size_t size,
+                                bool learnt);
+bool clause_arena_reserve(clause_arena_t *arena, size_t words);
+void clause_arena_free(clause_arena_t *arena, clause_ref_t ref);
+void clause_arena_shrink(clause_arena_t *arena, clause_ref_t ref, size_t size);
+clause_ref_t clause_arena_relocate(clause_arena_t *from, clause_arena_t *to, clause_ref_t ref);
+void clause_arena_dispose(clause_arena_t *arena);
+
+/* Cláusula apontada por uma referência (inválido após nova alocação na arena) */
+static inline clause_t* clause_arena_get(const clause_arena_t *arena, clause_ref_t ref) {
+    return (clause_t*)(arena->memory + ref);
+}
+
+/* Funções para listas de referências */
+bool clause_ref_list_push(clause_ref_list_t *list, clause_ref_t ref);
+void clause_ref_list_dispose(clause_ref_list_t *list);
+
+/* Funções para listas de observação */
+bool watch_list_push(watch_list_t *list, clause_ref_t clause, literal_t blocker);
+void watch_list_dispose(watch_list_t *list);
+
+/* Funções para o heap de variáveis */
+var_heap_t* var_heap_create(variable_t num_variables, const double *scores);
+void var_heap_destroy(var_heap_t *heap);
+bool var_heap_contains(const var_heap_t *heap, variable_t var);
+void var_heap_insert(var_heap_t *heap, variable_t var);
+void var_heap_increase(var_heap_t *heap, variable_t var);
+variable_t var_heap_pop(var_heap_t *heap);
 
 /* Funções para fórmula CNF */
 cnf_formula_t* cnf_create(variable_t num_variables);
 void cnf_destroy(cnf_formula_t *cnf);
-bool cnf_add_clause(cnf_formula_t *cnf, clause_t *clause);
+/* Literais sem duplicatas nem tautologias: normalizar antes (clause_normalize) */
+clause_ref_t cnf_add_clause_literals(cnf_formula_t *cnf, const literal_t *literals, size_t size,
+                                     bool learnt);
+void cnf_delete_clause(cnf_formula_t *cnf, clause_ref_t ref);
+bool cnf_append_formula(cnf_formula_t *cnf, const cnf_formula_t *other);
+void cnf_relocate_clauses(cnf_formula_t *cnf, clause_arena_t *to);
 bool cnf_is_satisfied(const cnf_formula_t *cnf);
 bool cnf_has_conflict(const cnf_formula_t *cnf);
 void cnf_update_caches(cnf_formula_t *cnf);
-void cnf_build_occurrence_lists(cnf_formula_t *cnf);
+bool cnf_build_occurrence_lists(cnf_formula_t *cnf);
+void cnf_free_occurrence_lists(cnf_formula_t *cnf);
+
+/* Cláusula de uma fórmula */
+static inline clause_t* cnf_clause(const cnf_formula_t *cnf, clause_ref_t ref) {
+    return clause_arena_get(&cnf->arena, ref);
+}
+
+/* Cláusulas que contêm o literal (exige cnf_build_occurrence_lists) */
+static inline const clause_ref_t* cnf_occurrences(const cnf_formula_t *cnf, literal_t lit,
+                                                  size_t *count) {
+    variable_t var = literal_variable(lit);
+    const size_t *offsets = lit > 0 ? cnf->positive_offsets : cnf->negative_offsets;
+    const clause_ref_t *refs = lit > 0 ? cnf->positive_occurrences : cnf->negative_occurrences;
+    *count = offsets[var + 1] - offsets[var];
+    return refs + offsets[var];
+}
 
 /* Funções para atribuições */
 assignment_stack_t* assignment_stack_create(size_t initial_capacity);
 void assignment_stack_destroy(assignment_stack_t *stack);
 bool assignment_stack_push(assignment_stack_t *stack, variable_t var, 
-                          var_assignment_t value, bool is_decision);
+                          var_assignment_t value, bool is_decision, clause_ref_t reason);
 bool assignment_stack_pop(assignment_stack_t *stack, assignment_entry_t *entry);
 void assignment_stack_backtrack_to_level(assignment_stack_t *stack, size_t level);
 void assignment_stack_clear(assignment_stack_t *stack);
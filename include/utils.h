@@ -64,6 +64,22 @@ typedef struct {
     uint64_t conflicts;          // Número de conflitos encontrados
     uint64_t restarts;          // Número de reinicializações
     uint64_t learned_clauses;   // Número de cláusulas aprendidas
+    uint64_t reductions;        // Reduções da base de cláusulas aprendidas
+    uint64_t deleted_clauses;   // Cláusulas aprendidas descartadas nas reduções
+    uint64_t kept_clauses;      // Cláusulas aprendidas mantidas na última redução
+    uint64_t eliminated_vars;   // Variáveis eliminadas por resolução (BVE)
+    uint64_t resolvents;        // Resolventes adicionados pela eliminação
+    uint64_t subsumed_clauses;  // Cláusulas removidas por subsunção
+    uint64_t strengthened_literals; // Literais removidos por resolução auto-subsumida
+    uint64_t failed_literals;   // Literais falhos encontrados pela sondagem
+    uint64_t implied_literals;  // Literais implicados pelas duas polaridades de uma sondagem
+    uint64_t hyper_binary;      // Resolventes hiper-binários adicionados
+    uint64_t substituted_vars;  // Variáveis trocadas pelo representante de sua classe de equivalência
+    uint64_t blocked_clauses;   // Cláusulas bloqueadas removidas (BCE)
+    uint64_t vivified_clauses;  // Cláusulas encurtadas pela vivificação
+    uint64_t vivified_literals; // Literais removidos pela vivificação
+    uint64_t inprocessings;     // Rodadas de inprocessamento durante a busca
+    uint64_t ticks;             // Esforço da propagação: literais propagados + observadores visitados
     double solve_time;          // Tempo total de resolução
     size_t max_decision_level;  // Nível máximo de decisão alcançado
 } solver_stats_t;
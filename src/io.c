@@ -0,0 +1,485 @@
+/**
+ * @file io.c
+ * @brief Entrada de arquivos com chamadas POSIX
+ * @author SAT Solver Team
+ * @date 2025
+ *
+ * - Mapeamento de arquivos em memória para o parser: o conteúdo é lido
+ *   diretamente das páginas do arquivo, sem cópias para buffers de linha.
+ * - Descompressão de gzip, xz e bzip2 em uma thread produtora, que entrega
+ *   blocos ao parser por uma fila limitada (descompressão e parsing em paralelo).
+ * Não inclui utils.h (conflito de timer_t com os cabeçalhos POSIX).
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "io.h"
+#include <bzlib.h>
+#include <fcntl.h>
+#include <lzma.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+/* ========== Informações de Arquivos ========== */
+
+io_path_kind_t io_path_kind(const char *filename) {
+    struct stat info;
+    if (!filename || stat(filename, &info) != 0) return IO_PATH_MISSING;
+    return S_ISREG(info.st_mode) ? IO_PATH_REGULAR : IO_PATH_OTHER;
+}
+
+bool io_stdin_is_terminal(void) {
+    return isatty(STDIN_FILENO) != 0;
+}
+
+/* ========== Mapeamento de Arquivos ========== */
+
+/**
+ * @brief Mapeia um arquivo regular inteiro em memória, somente leitura
+ * @param filename Caminho do arquivo
+ * @param mapping Saída: conteúdo e tamanho
+ * @return false se o arquivo não pode ser aberto, não é regular ou o mmap falha
+ *
+ * Arquivos vazios não são mapeados (mmap rejeita tamanho 0): o conteúdo
+ * devolvido é uma string vazia. O acesso é declarado sequencial para que
+ * o kernel antecipe a leitura das próximas páginas.
+ */
+bool io_map_file(const char *filename, io_mapping_t *mapping) {
+    if (!filename || !mapping) return false;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        close(fd);
+        return false;
+    }
+
+    mapping->size = (size_t)info.st_size;
+    mapping->address = NULL;
+    mapping->data = "";
+
+    if (mapping->size > 0) {
+        void *address = mmap(NULL, mapping->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        posix_madvise(address, mapping->size, POSIX_MADV_SEQUENTIAL);
+        mapping->address = address;
+        mapping->data = address;
+    }
+
+    /* O mapeamento continua válido após fechar o descritor */
+    close(fd);
+    return true;
+}
+
+void io_unmap(io_mapping_t *mapping) {
+    if (!mapping) return;
+    if (mapping->address) {
+        munmap(mapping->address, mapping->size);
+    }
+    mapping->address = NULL;
+    mapping->data = NULL;
+    mapping->size = 0;
+}
+
+/* ========== Execução Paralela ========== */
+
+typedef struct {
+    void (*task)(void *context, size_t index);
+    void *context;
+    size_t index;
+} io_task_t;
+
+static void* task_thread(void *argument) {
+    io_task_t *task = argument;
+    task->task(task->context, task->index);
+    return NULL;
+}
+
+/**
+ * @brief Executa count tarefas independentes em paralelo e espera todas
+ * @param count Número de tarefas
+ * @param task Função da tarefa (recebe o contexto e o índice)
+ * @param context Contexto compartilhado
+ *
+ * A tarefa 0 roda na thread chamadora. Se uma thread não puder ser
+ * criada, a tarefa correspondente roda na chamadora ao final, então
+ * todas as tarefas sempre executam.
+ */
+void io_parallel_for(size_t count, void (*task)(void *context, size_t index), void *context) {
+    if (count == 0) return;
+
+    pthread_t *threads = calloc(count, sizeof(pthread_t));
+    io_task_t *tasks = calloc(count, sizeof(io_task_t));
+    bool *started = calloc(count, sizeof(bool));
+    if (!threads || !tasks || !started) {
+        free(threads);
+        free(tasks);
+        free(started);
+        for (size_t i = 0; i < count; i++) task(context, i);
+        return;
+    }
+
+    for (size_t i = 1; i < count; i++) {
+        tasks[i].task = task;
+        tasks[i].context = context;
+        tasks[i].index = i;
+        started[i] = pthread_create(&threads[i], NULL, task_thread, &tasks[i]) == 0;
+    }
+    task(context, 0);
+    for (size_t i = 1; i < count; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            task(context, i);
+        }
+    }
+
+    free(threads);
+    free(tasks);
+    free(started);
+}
+
+size_t io_cpu_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+}
+
+/* ========== Descompressão em Segundo Plano ========== */
+
+#define IO_BLOCK_COUNT 4                /* Blocos em trânsito entre as threads */
+#define IO_BLOCK_SIZE  (256 * 1024)     /* Bytes descompactados por bloco */
+#define IO_INPUT_SIZE  (64 * 1024)      /* Buffer de leitura do arquivo compactado */
+
+typedef struct {
+    char *data;
+    size_t size;
+} io_block_t;
+
+struct io_decoder {
+    io_compression_t compression;
+
+    /* Estado do formato (usado apenas pela thread produtora) */
+    FILE *file;
+    gzFile gz;
+    lzma_stream lzma;
+    BZFILE *bz;
+    char bz_unused[BZ_MAX_UNUSED];
+    uint8_t *input;
+    bool stream_end;
+
+    /* Fila circular de blocos cheios */
+    io_block_t blocks[IO_BLOCK_COUNT];
+    size_t read_index;         // Próximo bloco a consumir
+    size_t write_index;        // Próximo bloco a preencher
+    size_t full_count;         // Blocos prontos para o consumidor
+    size_t read_offset;        // Bytes já consumidos do bloco corrente
+    bool finished;             // Produtor terminou (fim ou erro)
+    bool failed;               // Erro de leitura ou dado corrompido
+    bool cancelled;            // Consumidor encerrou antes do fim
+
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    pthread_t thread;
+};
+
+/**
+ * @brief Identifica a compressão pelos primeiros bytes do arquivo
+ * @param filename Caminho do arquivo
+ * @return Formato detectado, ou IO_COMPRESSION_NONE (inclusive se não abre)
+ */
+io_compression_t io_detect_compression(const char *filename) {
+    unsigned char magic[6] = {0};
+    FILE *file = fopen(filename, "rb");
+    if (!file) return IO_COMPRESSION_NONE;
+    size_t count = fread(magic, 1, sizeof(magic), file);
+    fclose(file);
+
+    if (count >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+        return IO_COMPRESSION_GZIP;
+    }
+    if (count >= 6 && memcmp(magic, "\xfd" "7zXZ" "\0", 6) == 0) {
+        return IO_COMPRESSION_XZ;
+    }
+    if (count >= 3 && memcmp(magic, "BZh", 3) == 0) {
+        return IO_COMPRESSION_BZIP2;
+    }
+    return IO_COMPRESSION_NONE;
+}
+
+const char* io_compression_to_string(io_compression_t compression) {
+    switch (compression) {
+        case IO_COMPRESSION_NONE: return "none";
+        case IO_COMPRESSION_GZIP: return "gzip";
+        case IO_COMPRESSION_XZ: return "xz";
+        case IO_COMPRESSION_BZIP2: return "bzip2";
+        default: return "unknown";
+    }
+}
+
+/* Cada decode_* preenche até size bytes; devolve 0 no fim e -1 em erro */
+
+static long decode_gzip(io_decoder_t *decoder, char *dest, size_t size) {
+    int count = gzread(decoder->gz, dest, (unsigned)size);
+    if (count < 0) return -1;
+    if (count == 0 && !gzeof(decoder->gz)) return -1;
+    return count;
+}
+
+static long decode_xz(io_decoder_t *decoder, char *dest, size_t size) {
+    lzma_stream *stream = &decoder->lzma;
+    if (decoder->stream_end) return 0;
+
+    stream->next_out = (uint8_t*)dest;
+    stream->avail_out = size;
+
+    while (stream->avail_out > 0) {
+        lzma_action action = LZMA_RUN;
+        if (stream->avail_in == 0 && !feof(decoder->file)) {
+            stream->next_in = decoder->input;
+            stream->avail_in = fread(decoder->input, 1, IO_INPUT_SIZE, decoder->file);
+            if (ferror(decoder->file)) return -1;
+        }
+        if (stream->avail_in == 0 && feof(decoder->file)) {
+            action = LZMA_FINISH;
+        }
+
+        lzma_ret ret = lzma_code(stream, action);
+        if (ret == LZMA_STREAM_END) {
+            decoder->stream_end = true;
+            break;
+        }
+        if (ret != LZMA_OK) return -1;
+    }
+    return (long)(size - stream->avail_out);
+}
+
+/* bzip2 paralelo (pbzip2) gera vários streams concatenados: reabrir após cada fim */
+static long decode_bzip2(io_decoder_t *decoder, char *dest, size_t size) {
+    size_t produced = 0;
+
+    while (produced < size && !decoder->stream_end) {
+        int error;
+        int count = BZ2_bzRead(&error, decoder->bz, dest + produced, (int)(size - produced));
+        if (error != BZ_OK && error != BZ_STREAM_END) return -1;
+        produced += (size_t)count;
+        if (error == BZ_OK) continue;
+
+        void *unused;
+        int unused_count;
+        BZ2_bzReadGetUnused(&error, decoder->bz, &unused, &unused_count);
+        if (error != BZ_OK) return -1;
+        memcpy(decoder->bz_unused, unused, (size_t)unused_count);
+        BZ2_bzReadClose(&error, decoder->bz);
+        decoder->bz = NULL;
+
+        if (unused_count == 0) {
+            int c = getc(decoder->file);
+            if (c == EOF) {
+                decoder->stream_end = true;
+                break;
+            }
+            ungetc(c, decoder->file);
+        }
+        decoder->bz = BZ2_bzReadOpen(&error, decoder->file, 0, 0,
+                                     decoder->bz_unused, unused_count);
+        if (error != BZ_OK) return -1;
+    }
+    return (long)produced;
+}
+
+static long decode_block(io_decoder_t *decoder, char *dest, size_t size) {
+    switch (decoder->compression) {
+        case IO_COMPRESSION_GZIP: return decode_gzip(decoder, dest, size);
+        case IO_COMPRESSION_XZ: return decode_xz(decoder, dest, size);
+        case IO_COMPRESSION_BZIP2: return decode_bzip2(decoder, dest, size);
+        default: return -1;
+    }
+}
+
+/* Thread produtora: descompacta bloco a bloco enquanto houver espaço na fila */
+static void* decoder_thread(void *argument) {
+    io_decoder_t *decoder = argument;
+
+    for (;;) {
+        pthread_mutex_lock(&decoder->lock);
+        while (decoder->full_count == IO_BLOCK_COUNT && !decoder->cancelled) {
+            pthread_cond_wait(&decoder->not_full, &decoder->lock);
+        }
+        if (decoder->cancelled) {
+            pthread_mutex_unlock(&decoder->lock);
+            break;
+        }
+        io_block_t *block = &decoder->blocks[decoder->write_index];
+        pthread_mutex_unlock(&decoder->lock);
+
+        /* Descompressão fora da seção crítica: o consumidor não toca blocos livres */
+        long count = decode_block(decoder, block->data, IO_BLOCK_SIZE);
+
+        pthread_mutex_lock(&decoder->lock);
+        if (count <= 0) {
+            decoder->failed = count < 0;
+            decoder->finished = true;
+            pthread_cond_signal(&decoder->not_empty);
+            pthread_mutex_unlock(&decoder->lock);
+            break;
+        }
+        block->size = (size_t)count;
+        decoder->write_index = (decoder->write_index + 1) % IO_BLOCK_COUNT;
+        decoder->full_count++;
+        pthread_cond_signal(&decoder->not_empty);
+        pthread_mutex_unlock(&decoder->lock);
+    }
+    return NULL;
+}
+
+static bool decoder_open_format(io_decoder_t *decoder, const char *filename) {
+    switch (decoder->compression) {
+        case IO_COMPRESSION_GZIP:
+            decoder->gz = gzopen(filename, "rb");
+            if (!decoder->gz) return false;
+            gzbuffer(decoder->gz, IO_INPUT_SIZE);
+            return true;
+
+        case IO_COMPRESSION_XZ: {
+            decoder->file = fopen(filename, "rb");
+            decoder->input = malloc(IO_INPUT_SIZE);
+            lzma_stream initial = LZMA_STREAM_INIT;
+            decoder->lzma = initial;
+            return decoder->file && decoder->input &&
+                   lzma_stream_decoder(&decoder->lzma, UINT64_MAX, LZMA_CONCATENATED) == LZMA_OK;
+        }
+
+        case IO_COMPRESSION_BZIP2: {
+            int error;
+            decoder->file = fopen(filename, "rb");
+            if (!decoder->file) return false;
+            decoder->bz = BZ2_bzReadOpen(&error, decoder->file, 0, 0, NULL, 0);
+            return error == BZ_OK;
+        }
+
+        default:
+            return false;
+    }
+}
+
+static void decoder_close_format(io_decoder_t *decoder) {
+    if (decoder->gz) gzclose(decoder->gz);
+    if (decoder->compression == IO_COMPRESSION_XZ) lzma_end(&decoder->lzma);
+    if (decoder->bz) {
+        int error;
+        BZ2_bzReadClose(&error, decoder->bz);
+    }
+    if (decoder->file) fclose(decoder->file);
+    free(decoder->input);
+}
+
+/**
+ * @brief Abre um arquivo compactado e inicia a thread de descompressão
+ * @param filename Caminho do arquivo
+ * @param compression Formato (de io_detect_compression)
+ * @return Descompressor, ou NULL se o arquivo ou a thread não puderam ser criados
+ */
+io_decoder_t* io_decoder_open(const char *filename, io_compression_t compression) {
+    if (!filename || compression == IO_COMPRESSION_NONE) return NULL;
+
+    io_decoder_t *decoder = calloc(1, sizeof(io_decoder_t));
+    if (!decoder) return NULL;
+    decoder->compression = compression;
+
+    bool ok = decoder_open_format(decoder, filename);
+    for (size_t i = 0; ok && i < IO_BLOCK_COUNT; i++) {
+        decoder->blocks[i].data = malloc(IO_BLOCK_SIZE);
+        ok = decoder->blocks[i].data != NULL;
+    }
+
+    if (ok) {
+        pthread_mutex_init(&decoder->lock, NULL);
+        pthread_cond_init(&decoder->not_empty, NULL);
+        pthread_cond_init(&decoder->not_full, NULL);
+        if (pthread_create(&decoder->thread, NULL, decoder_thread, decoder) == 0) {
+            return decoder;
+        }
+        pthread_mutex_destroy(&decoder->lock);
+        pthread_cond_destroy(&decoder->not_empty);
+        pthread_cond_destroy(&decoder->not_full);
+    }
+
+    decoder_close_format(decoder);
+    for (size_t i = 0; i < IO_BLOCK_COUNT; i++) {
+        free(decoder->blocks[i].data);
+    }
+    free(decoder);
+    return NULL;
+}
+
+/**
+ * @brief Copia bytes descompactados para dest, esperando a thread se preciso
+ * @param source Descompressor (void* para servir como fonte de bytes do parser)
+ * @param dest Destino
+ * @param size Capacidade de dest
+ * @return Bytes copiados (no máximo um bloco por chamada); 0 no fim ou em erro
+ */
+size_t io_decoder_read(void *source, char *dest, size_t size) {
+    io_decoder_t *decoder = source;
+
+    pthread_mutex_lock(&decoder->lock);
+    while (decoder->full_count == 0 && !decoder->finished) {
+        pthread_cond_wait(&decoder->not_empty, &decoder->lock);
+    }
+    if (decoder->full_count == 0) {
+        pthread_mutex_unlock(&decoder->lock);
+        return 0;
+    }
+    io_block_t *block = &decoder->blocks[decoder->read_index];
+    pthread_mutex_unlock(&decoder->lock);
+
+    size_t count = block->size - decoder->read_offset;
+    if (count > size) count = size;
+    memcpy(dest, block->data + decoder->read_offset, count);
+    decoder->read_offset += count;
+
+    if (decoder->read_offset == block->size) {
+        pthread_mutex_lock(&decoder->lock);
+        decoder->read_offset = 0;
+        decoder->read_index = (decoder->read_index + 1) % IO_BLOCK_COUNT;
+        decoder->full_count--;
+        pthread_cond_signal(&decoder->not_full);
+        pthread_mutex_unlock(&decoder->lock);
+    }
+    return count;
+}
+
+bool io_decoder_close(io_decoder_t *decoder) {
+    if (!decoder) return false;
+
+    /* O parser pode parar antes do fim (erro ou '%'): liberar o produtor */
+    pthread_mutex_lock(&decoder->lock);
+    decoder->cancelled = true;
+    pthread_cond_signal(&decoder->not_full);
+    pthread_mutex_unlock(&decoder->lock);
+    pthread_join(decoder->thread, NULL);
+
+    bool ok = !decoder->failed;
+
+    pthread_mutex_destroy(&decoder->lock);
+    pthread_cond_destroy(&decoder->not_empty);
+    pthread_cond_destroy(&decoder->not_full);
+    decoder_close_format(decoder);
+    for (size_t i = 0; i < IO_BLOCK_COUNT; i++) {
+        free(decoder->blocks[i].data);
+    }
+    free(decoder);
+    return ok;
+}
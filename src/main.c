@@ -13,6 +13,7 @@
 #include <string.h>
 #include <time.h>
 
+#include "io.h"
 #include "parser.h"
 #include "solver.h"
 #include "utils.h"
@@ -47,8 +48,20 @@ typedef struct {
     bool show_stats;                    ///< Flag para mostrar estatísticas de performance
     bool help;                          ///< Flag para mostrar ajuda
     decision_strategy_t strategy;       ///< Estratégia de escolha de variáveis
+    search_mode_t search_mode;          ///< Modo de busca (DPLL ou CDCL)
+    bool enable_restarts;               ///< Flag para ativar reinicializações
+    restart_policy_t restart_policy;    ///< Política de reinicialização
     double timeout;                     ///< Timeout em segundos (0 = sem limite)
     size_t max_decisions;              ///< Máximo de decisões (0 = sem limite)
+    size_t parse_threads;               ///< Threads de parsing (0 = automático)
+    bool disable_elimination;           ///< Desativar a eliminação de variáveis (BVE)
+    bool disable_subsumption;           ///< Desativar a subsunção e a auto-subsunção
+    bool disable_probing;               ///< Desativar a sondagem de literais falhos
+    bool disable_equivalences;          ///< Desativar a substituição de literais equivalentes
+    bool disable_blocked;               ///< Desativar a eliminação de cláusulas bloqueadas
+    bool disable_vivification;          ///< Desativar a vivificação na busca CDCL
+    bool disable_inprocessing;          ///< Desativar as simplificações durante a busca CDCL
+    char *binary_output;                ///< Arquivo binário a gerar (NULL = resolver)
 } cmd_args_t;
 
 /**
@@ -57,21 +70,43 @@ typedef struct {
  */
 void print_help(const char *program_name) {
     printf("SAT Solver em C - Algoritmo DPLL\n\n");
-    printf("Uso: %s [opções] <arquivo.cnf>\n\n", program_name);
+    printf("Uso: %s [opções] [arquivo.cnf | -]\n\n", program_name);
+    printf("Sem arquivo (ou com -), a fórmula é lida da entrada padrão.\n\n");
     printf("Opções:\n");
     printf("  -h, --help           Mostrar esta ajuda\n");
     printf("  -v, --verbose        Modo verboso\n");
     printf("  -a, --assignment     Mostrar atribuição das variáveis\n");
     printf("  -s, --stats          Mostrar estatísticas detalhadas\n");
-    printf("  -t, --timeout <seg>  Timeout em segundos (padrão: sem limite)\n");
-    printf("  -d, --decisions <n>  Máximo de decisões (padrão: sem limite)\n");
+    printf("  -t, --timeout <seg>  Timeout em segundos (padrão: sem limite; DPLL: 5)\n");
+    printf("  -d, --decisions <n>  Máximo de decisões (padrão: sem limite; DPLL: 1000)\n");
     printf("  --strategy <tipo>    Estratégia de decisão:\n");
     printf("                       first    - Primeira não atribuída (padrão)\n");
     printf("                       frequent - Mais frequente\n");
     printf("                       jw       - Jeroslow-Wang\n");
     printf("                       random   - Aleatória\n");
+    printf("                       vsids    - Atividade em conflitos (VSIDS)\n");
+    printf("  --mode <tipo>        Modo de busca:\n");
+    printf("                       dpll     - Backtracking cronológico (padrão)\n");
+    printf("                       cdcl     - Aprendizado de cláusulas e backjumping\n");
+    printf("  --restart <tipo>     Política de reinicialização:\n");
+    printf("                       none      - Sem reinicializações (padrão)\n");
+    printf("                       fixed     - A cada 1000 conflitos\n");
+    printf("                       luby      - Sequência de Luby\n");
+    printf("                       geometric - Intervalos crescentes (x1.5)\n");
+    printf("                       glucose   - Médias móveis do LBD, com bloqueio\n");
+    printf("  --no-elim            Desativar a eliminação de variáveis (BVE)\n");
+    printf("  --no-subsume         Desativar a subsunção de cláusulas\n");
+    printf("  --no-probe           Desativar a sondagem de literais falhos\n");
+    printf("  --no-equiv           Desativar a substituição de literais equivalentes\n");
+    printf("  --no-bce             Desativar a eliminação de cláusulas bloqueadas\n");
+    printf("  --no-vivify          Desativar a vivificação de cláusulas (CDCL)\n");
+    printf("  --no-inprocess       Desativar as simplificações durante a busca (CDCL)\n");
+    printf("  --parse-threads <n>  Threads para o parsing de arquivos grandes\n");
+    printf("                       (padrão: 1; 0 = número de processadores)\n");
+    printf("  --write-binary <arq> Salvar a fórmula no formato binário e sair\n");
+    printf("                       (carregado automaticamente nas próximas execuções)\n");
     printf("\n");
-    printf("Formato de entrada: DIMACS CNF\n");
+    printf("Formato de entrada: DIMACS CNF (também compactado: .gz, .xz, .bz2)\n");
     printf("Código de saída:\n");
     printf("  10 - SATISFIABLE\n");
     printf("  20 - UNSATISFIABLE\n");
@@ -81,6 +116,8 @@ void print_help(const char *program_name) {
     printf("Exemplos:\n");
     printf("  %s exemplo.cnf\n", program_name);
     printf("  %s -v -s --strategy jw problema.cnf\n", program_name);
+    printf("  %s --mode cdcl problema.cnf\n", program_name);
+    printf("  %s --mode cdcl --strategy vsids --restart glucose problema.cnf\n", program_name);
     printf("  %s --timeout 60 --decisions 10000 formula.cnf\n", program_name);
 }
 
@@ -89,6 +126,9 @@ bool parse_arguments(int argc, char *argv[], cmd_args_t *args) {
     /* Inicializar com valores padrão */
     memset(args, 0, sizeof(cmd_args_t));
     args->strategy = DECISION_FIRST_UNASSIGNED;
+    args->search_mode = SEARCH_DPLL;
+    args->restart_policy = RESTART_FIXED;
+    args->parse_threads = 1;
     
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
@@ -140,17 +180,96 @@ bool parse_arguments(int argc, char *argv[], cmd_args_t *args) {
                 args->strategy = DECISION_JEROSLOW_WANG;
             } else if (strcmp(strategy, "random") == 0) {
                 args->strategy = DECISION_RANDOM;
+            } else if (strcmp(strategy, "vsids") == 0) {
+                args->strategy = DECISION_VSIDS;
             } else {
                 log_error("Estratégia desconhecida: %s", strategy);
                 return false;
             }
         }
-        else if (argv[i][0] == '-') {
+        else if (strcmp(argv[i], "--mode") == 0) {
+            if (i + 1 >= argc) {
+                log_error("Opção --mode requer um valor");
+                return false;
+            }
+            char *mode = argv[++i];
+            if (strcmp(mode, "dpll") == 0) {
+                args->search_mode = SEARCH_DPLL;
+            } else if (strcmp(mode, "cdcl") == 0) {
+                args->search_mode = SEARCH_CDCL;
+            } else {
+                log_error("Modo de busca desconhecido: %s", mode);
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--restart") == 0) {
+            if (i + 1 >= argc) {
+                log_error("Opção --restart requer um valor");
+                return false;
+            }
+            char *policy = argv[++i];
+            args->enable_restarts = true;
+            if (strcmp(policy, "none") == 0) {
+                args->enable_restarts = false;
+            } else if (strcmp(policy, "fixed") == 0) {
+                args->restart_policy = RESTART_FIXED;
+            } else if (strcmp(policy, "luby") == 0) {
+                args->restart_policy = RESTART_LUBY;
+            } else if (strcmp(policy, "geometric") == 0) {
+                args->restart_policy = RESTART_GEOMETRIC;
+            } else if (strcmp(policy, "glucose") == 0) {
+                args->restart_policy = RESTART_GLUCOSE;
+            } else {
+                log_error("Política de reinicialização desconhecida: %s", policy);
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--no-elim") == 0) {
+            args->disable_elimination = true;
+        }
+        else if (strcmp(argv[i], "--no-subsume") == 0) {
+            args->disable_subsumption = true;
+        }
+        else if (strcmp(argv[i], "--no-probe") == 0) {
+            args->disable_probing = true;
+        }
+        else if (strcmp(argv[i], "--no-equiv") == 0) {
+            args->disable_equivalences = true;
+        }
+        else if (strcmp(argv[i], "--no-bce") == 0) {
+            args->disable_blocked = true;
+        }
+        else if (strcmp(argv[i], "--no-vivify") == 0) {
+            args->disable_vivification = true;
+        }
+        else if (strcmp(argv[i], "--no-inprocess") == 0) {
+            args->disable_inprocessing = true;
+        }
+        else if (strcmp(argv[i], "--parse-threads") == 0) {
+            if (i + 1 >= argc) {
+                log_error("Opção --parse-threads requer um valor");
+                return false;
+            }
+            long threads;
+            if (!parse_long(argv[++i], &threads) || threads < 0) {
+                log_error("Número de threads inválido: %s", argv[i]);
+                return false;
+            }
+            args->parse_threads = (size_t)threads;
+        }
+        else if (strcmp(argv[i], "--write-binary") == 0) {
+            if (i + 1 >= argc) {
+                log_error("Opção --write-binary requer um valor");
+                return false;
+            }
+            args->binary_output = argv[++i];
+        }
+        else if (argv[i][0] == '-' && argv[i][1] != '\0') {
             log_error("Opção desconhecida: %s", argv[i]);
             return false;
         }
         else {
-            /* Arquivo de entrada */
+            /* Arquivo de entrada ("-" = entrada padrão) */
             if (args->input_file) {
                 log_error("Múltiplos arquivos de entrada especificados");
                 return false;
@@ -166,12 +285,17 @@ bool parse_arguments(int argc, char *argv[], cmd_args_t *args) {
 bool validate_arguments(const cmd_args_t *args) {
     if (args->help) return true;
     
+    /* Sem arquivo, lê da entrada padrão, desde que ela não seja o terminal */
     if (!args->input_file) {
-        log_error("Arquivo de entrada não especificado");
-        return false;
+        if (io_stdin_is_terminal()) {
+            log_error("Arquivo de entrada não especificado");
+            return false;
+        }
+        return true;
     }
     
-    if (!file_exists(args->input_file)) {
+    /* Verificado sem abrir: abrir um FIFO para testar consumiria a entrada */
+    if (strcmp(args->input_file, "-") != 0 && io_path_kind(args->input_file) == IO_PATH_MISSING) {
         log_error("Arquivo não encontrado: %s", args->input_file);
         return false;
     }
@@ -186,6 +310,19 @@ const char* strategy_to_string(decision_strategy_t strategy) {
         case DECISION_MOST_FREQUENT: return "most-frequent";
         case DECISION_JEROSLOW_WANG: return "jeroslow-wang";
         case DECISION_RANDOM: return "random";
+        case DECISION_VSIDS: return "vsids";
+        default: return "unknown";
+    }
+}
+
+/* Função para converter política de reinicialização para string */
+const char* restart_policy_to_string(bool enabled, restart_policy_t policy) {
+    if (!enabled) return "none";
+    switch (policy) {
+        case RESTART_FIXED: return "fixed";
+        case RESTART_LUBY: return "luby";
+        case RESTART_GEOMETRIC: return "geometric";
+        case RESTART_GLUCOSE: return "glucose";
         default: return "unknown";
     }
 }
@@ -214,10 +351,17 @@ int main(int argc, char *argv[]) {
         return 1;
     }
     
+    if (!args.input_file) {
+        args.input_file = "-";
+    }
+    
     if (args.verbose) {
         log_info("SAT Solver iniciado");
-        log_info("Arquivo: %s", args.input_file);
+        log_info("Arquivo: %s", strcmp(args.input_file, "-") == 0 ? "entrada padrão" : args.input_file);
         log_info("Estratégia: %s", strategy_to_string(args.strategy));
+        log_info("Modo de busca: %s", args.search_mode == SEARCH_CDCL ? "cdcl" : "dpll");
+        log_info("Reinicializações: %s",
+                 restart_policy_to_string(args.enable_restarts, args.restart_policy));
         if (args.timeout > 0) {
             log_info("Timeout: %.2f segundos", args.timeout);
         }
@@ -232,6 +376,7 @@ int main(int argc, char *argv[]) {
         log_error("Erro ao criar parser");
         return 1;
     }
+    parser->parse_threads = args.parse_threads;
     
     parse_result_t parse_result = parser_parse_file(parser, args.input_file);
     if (parse_result != PARSE_OK) {
@@ -243,6 +388,10 @@ int main(int argc, char *argv[]) {
         return 1;
     }
     
+    if (args.verbose) {
+        parse_stats_print(&parser->stats);
+    }
+    
     cnf_formula_t *formula = parser->formula;
     parser->formula = NULL; /* Transferir propriedade */
     parser_destroy(parser);
@@ -252,12 +401,34 @@ int main(int argc, char *argv[]) {
         cnf_print_stats(formula);
     }
     
+    /* Apenas converter para o formato binário */
+    if (args.binary_output) {
+        bool written = parser_write_binary(formula, args.binary_output, false);
+        if (written) {
+            log_info("Fórmula salva no formato binário: %s", args.binary_output);
+        } else {
+            log_error("Não foi possível escrever %s", args.binary_output);
+        }
+        cnf_destroy(formula);
+        return written ? 0 : 1;
+    }
+    
     /* Configurar solver */
     solver_config_t config = DEFAULT_SOLVER_CONFIG;
     config.decision_strategy = args.strategy;
+    config.search_mode = args.search_mode;
+    config.enable_restarts = args.enable_restarts;
+    config.restart_policy = args.restart_policy;
     config.verbose = args.verbose;
     config.timeout_seconds = args.timeout;
     config.max_decisions = args.max_decisions;
+    config.enable_elimination = !args.disable_elimination;
+    config.enable_subsumption = !args.disable_subsumption;
+    config.enable_probing = !args.disable_probing;
+    config.enable_equivalences = !args.disable_equivalences;
+    config.enable_blocked = !args.disable_blocked;
+    config.enable_vivification = !args.disable_vivification;
+    config.enable_inprocessing = !args.disable_inprocessing;
     
     /* Criar e executar solver */
     dpll_solver_t *solver = solver_create_with_config(formula, &config);
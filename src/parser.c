@@ -10,12 +10,15 @@
  * - Validação rigorosa de formato
  * - Tratamento de erros com mensagens detalhadas
  * - Configurações flexíveis (modo estrito/permissivo)
+ * - Leitura de arquivos via mmap com scanner de inteiros próprio
  */
 
 #include "parser.h"
+#include "io.h"
 #include "utils.h"
 #include <string.h>
 #include <ctype.h>
+#include <stdarg.h>
 
 /**
  * @brief Configuração padrão do parser (modo permissivo)
@@ -51,10 +54,14 @@ cnf_parser_t* parser_create(bool strict_mode, bool verbose) {
     parser->info.parsed_clauses = 0;
     parser->info.max_variables = 0;
     parser->info.error_message[0] = '\0';
+    parse_stats_init(&parser->stats);
     
     parser->formula = NULL;
+    parser->normalizer.marks = NULL;
     parser->strict_mode = strict_mode;
     parser->verbose = verbose;
+    parser->sort_literals = false;
+    parser->parse_threads = 1;
     
     return parser;
 }
@@ -73,6 +80,7 @@ void parser_destroy(cnf_parser_t *parser) {
         if (parser->formula) {
             cnf_destroy(parser->formula);
         }
+        clause_normalizer_dispose(&parser->normalizer);
         free(parser);
     }
 }
@@ -83,197 +91,988 @@ void parser_reset(cnf_parser_t *parser) {
             cnf_destroy(parser->formula);
             parser->formula = NULL;
         }
+        clause_normalizer_dispose(&parser->normalizer);
         
         parser->info.line_number = 0;
         parser->info.expected_clauses = 0;
         parser->info.parsed_clauses = 0;
         parser->info.max_variables = 0;
         parser->info.error_message[0] = '\0';
+        parse_stats_init(&parser->stats);
     }
 }
 
-/* ========== Funções de Parsing ========== */
+/* ========== Scanner DIMACS ========== */
 
-parse_result_t parser_parse_file(cnf_parser_t *parser, const char *filename) {
-    if (!parser || !filename) return PARSE_ERROR_INVALID_FORMAT;
-    
-    if (!file_exists(filename)) {
-        snprintf(parser->info.error_message, sizeof(parser->info.error_message),
-                "Arquivo não encontrado: %s", filename);
-        return PARSE_ERROR_FILE_NOT_FOUND;
+#define PARSER_BUFFER_SIZE (64 * 1024)  /* Buffer de leitura para streams */
+
+/* Fonte de bytes do scanner: devolve quantos bytes leu (0 = fim da entrada) */
+typedef size_t (*dimacs_read_fn)(void *source, char *dest, size_t size);
+
+/*
+ * Janela de entrada do scanner: [pos, end). Entradas em memória trazem
+ * todo o conteúdo na janela (read == NULL); streams usam um buffer que é
+ * compactado e reabastecido por input_refill.
+ */
+typedef struct {
+    const char *pos;
+    const char *end;
+    char *buffer;              // Buffer próprio (streams) ou NULL
+    size_t capacity;
+    dimacs_read_fn read;
+    void *source;
+    size_t bytes;              // Total de bytes entregues ao scanner
+    bool eof;
+} dimacs_input_t;
+
+static void input_init_memory(dimacs_input_t *in, const char *data, size_t size) {
+    memset(in, 0, sizeof(*in));
+    in->pos = data;
+    in->end = data + size;
+    in->bytes = size;
+    in->eof = true;
+}
+
+static void input_init_stream(dimacs_input_t *in, char *buffer, size_t capacity,
+                              dimacs_read_fn read, void *source) {
+    memset(in, 0, sizeof(*in));
+    in->pos = buffer;
+    in->end = buffer;
+    in->buffer = buffer;
+    in->capacity = capacity;
+    in->read = read;
+    in->source = source;
+}
+
+/**
+ * @brief Move o trecho não consumido para o início do buffer e lê mais bytes
+ * @param in Entrada
+ * @return true se novos bytes foram lidos; false no fim da entrada
+ *
+ * O trecho pendente é preservado, então um token cortado na fronteira do
+ * buffer continua inteiro após o reabastecimento.
+ */
+static bool input_refill(dimacs_input_t *in) {
+    if (in->eof) return false;
+
+    size_t pending = (size_t)(in->end - in->pos);
+    memmove(in->buffer, in->pos, pending);
+
+    size_t count = in->read(in->source, in->buffer + pending, in->capacity - pending);
+    if (count == 0) in->eof = true;
+
+    in->pos = in->buffer;
+    in->end = in->buffer + pending + count;
+    in->bytes += count;
+    return count > 0;
+}
+
+static size_t read_stream(void *source, char *dest, size_t size) {
+    return fread(dest, 1, size, (FILE*)source);
+}
+
+/* Classificação da linha corrente, para as estatísticas */
+typedef enum {
+    LINE_EMPTY,
+    LINE_COMMENT,
+    LINE_PROBLEM,
+    LINE_CLAUSE
+} line_kind_t;
+
+static parse_result_t parse_error(cnf_parser_t *parser, parse_result_t result,
+                                  const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(parser->info.error_message, sizeof(parser->info.error_message), format, args);
+    va_end(args);
+    return result;
+}
+
+static inline bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static void count_line(parse_stats_t *stats, line_kind_t kind) {
+    stats->total_lines++;
+    switch (kind) {
+        case LINE_EMPTY:   stats->empty_lines++;   break;
+        case LINE_COMMENT: stats->comment_lines++; break;
+        case LINE_PROBLEM: stats->problem_lines++; break;
+        case LINE_CLAUSE:  stats->clause_lines++;  break;
     }
-    
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        snprintf(parser->info.error_message, sizeof(parser->info.error_message),
-                "Não foi possível abrir o arquivo: %s", filename);
-        return PARSE_ERROR_FILE_NOT_FOUND;
+}
+
+/**
+ * @brief Conclui a cláusula acumulada ao encontrar o terminador 0
+ * @param parser Parser com a fórmula de destino
+ * @param clause Literais lidos (podem ter duplicatas)
+ * @return PARSE_OK, ou erro para cláusula vazia no modo rigoroso / falta de memória
+ */
+static parse_result_t finish_clause(cnf_parser_t *parser, literal_vector_t *clause) {
+    if (clause->size == 0) {
+        if (parser->strict_mode) {
+            return parse_error(parser, PARSE_ERROR_INVALID_CLAUSE,
+                               "Cláusula vazia não permitida no modo rigoroso (linha %d)",
+                               parser->info.line_number);
+        }
+        return PARSE_OK; /* Ignorar cláusula vazia */
     }
-    
+
+    /* Remover duplicatas e ignorar tautologias (não alteram a satisfatibilidade) */
+    if (!clause_normalize(&parser->normalizer, clause->literals, &clause->size)) {
+        if (parser->verbose) {
+            log_debug("Ignorando cláusula tautológica na linha %d", parser->info.line_number);
+        }
+        clause->size = 0;
+        return PARSE_OK;
+    }
+
+    /* Copiar a cláusula para a arena da fórmula */
+    if (cnf_add_clause_literals(parser->formula, clause->literals, clause->size,
+                                false) == CLAUSE_REF_UNDEF) {
+        return PARSE_ERROR_MEMORY;
+    }
+    clause->size = 0;
+    parser->info.parsed_clauses++;
+
+    if (parser->verbose && parser->info.parsed_clauses % 100000 == 0) {
+        log_debug("Processadas %d cláusulas...", parser->info.parsed_clauses);
+    }
+    return PARSE_OK;
+}
+
+/**
+ * @brief Processa a linha "p cnf" a partir de pos (que aponta para o 'p')
+ * @param parser Parser a configurar
+ * @param in Entrada; ao retornar, pos aponta para o fim da linha
+ * @return Resultado de parse_problem_line ou erro de memória
+ */
+static parse_result_t scan_problem_line(cnf_parser_t *parser, dimacs_input_t *in) {
+    char line[256];
+    size_t length = 0;
+
+    while (in->pos < in->end || input_refill(in)) {
+        if (*in->pos == '\n') break;
+        if (length + 1 < sizeof(line)) line[length++] = *in->pos;
+        in->pos++;
+    }
+    line[length] = '\0';
+
+    if (parser->formula) {
+        return parse_error(parser, PARSE_ERROR_INVALID_PROBLEM_LINE,
+                           "Múltiplas linhas de definição encontradas");
+    }
+
+    int num_vars, num_clauses;
+    parse_result_t result = parse_problem_line(trim_string(line), &num_vars, &num_clauses);
+    if (result != PARSE_OK) {
+        return parse_error(parser, result, "Linha de definição inválida: %s", line);
+    }
+
+    parser->info.max_variables = num_vars;
+    parser->info.expected_clauses = num_clauses;
+
+    /* Criar a fórmula CNF e as marcas de normalização das cláusulas */
+    parser->formula = cnf_create(num_vars);
+    if (!parser->formula ||
+        !clause_normalizer_init(&parser->normalizer, num_vars, parser->sort_literals)) {
+        return PARSE_ERROR_MEMORY;
+    }
+
     if (parser->verbose) {
-        log_info("Parsing arquivo: %s", filename);
+        log_info("Problema: %d variáveis, %d cláusulas", num_vars, num_clauses);
     }
-    
-    parse_result_t result = parser_parse_stream(parser, file);
-    fclose(file);
-    
-    return result;
+    return PARSE_OK;
 }
 
-parse_result_t parser_parse_string(cnf_parser_t *parser, const char *content) {
-    if (!parser || !content) return PARSE_ERROR_INVALID_FORMAT;
-    
-    /* Criar um stream temporário da string */
-    FILE *stream = tmpfile();
-    if (!stream) return PARSE_ERROR_MEMORY;
-    
-    fprintf(stream, "%s", content);
-    rewind(stream);
-    
-    parse_result_t result = parser_parse_stream(parser, stream);
-    fclose(stream);
-    
-    return result;
+/**
+ * @brief Lê um literal a partir de pos com um scanner de inteiros próprio
+ * @param parser Parser (para mensagens de erro)
+ * @param in Entrada; ao retornar, pos aponta para depois do literal
+ * @param literal Saída: valor lido
+ * @return PARSE_OK, PARSE_ERROR_INVALID_CLAUSE ou PARSE_ERROR_VARIABLE_OUT_OF_RANGE
+ *
+ * Evita strtok/strtol: cada dígito custa uma comparação e uma
+ * multiplicação, e o token precisa terminar em espaço ou fim de entrada.
+ * Um token cortado pelo fim da janela (streams) continua após
+ * input_refill: sinal e dígitos já lidos ficam no estado local, então
+ * tokens de qualquer tamanho (zeros à esquerda inclusive) são aceitos.
+ */
+static parse_result_t scan_literal(cnf_parser_t *parser, dimacs_input_t *in, int *literal) {
+    const char *start = in->pos;
+    const char *p = start;
+    bool negative = false;
+    bool digits = false;
+    uint64_t value = 0;
+
+    if (*p == '-') {
+        negative = true;
+        p++;
+    }
+    for (;;) {
+        if (p == in->end) {
+            in->pos = p;
+            if (!input_refill(in)) break;
+            start = p = in->pos;
+        }
+        if ((unsigned)(*p - '0') > 9) break;
+        value = value * 10 + (uint64_t)(*p - '0');
+        if (value > INT32_MAX) {
+            in->pos = p;
+            return parse_error(parser, PARSE_ERROR_VARIABLE_OUT_OF_RANGE,
+                               "Literal fora do intervalo na linha %d",
+                               parser->info.line_number);
+        }
+        digits = true;
+        p++;
+    }
+
+    const char *end = in->end;
+    if (!digits || (p < end && !is_blank(*p) && *p != '\n')) {
+        goto invalid;
+    }
+
+    in->pos = p;
+    *literal = negative ? -(int)value : (int)value;
+    return PARSE_OK;
+
+invalid:
+    while (p < end && !is_blank(*p) && *p != '\n') p++;
+    return parse_error(parser, PARSE_ERROR_INVALID_CLAUSE,
+                       "Token inválido na linha %d: '%.*s'", parser->info.line_number,
+                       (int)(p - start < 32 ? p - start : 32), start);
 }
 
-parse_result_t parser_parse_stream(cnf_parser_t *parser, FILE *stream) {
-    if (!parser || !stream) return PARSE_ERROR_INVALID_FORMAT;
-    
-    parser_reset(parser);
-    
-    char line[MAX_LINE_LENGTH];
-    bool problem_line_found = false;
-    timer_t timer;
-    timer_start(&timer);
-    
-    while (fgets(line, sizeof(line), stream)) {
-        parser->info.line_number++;
-        
-        /* Remover quebra de linha */
-        char *newline = strchr(line, '\n');
-        if (newline) *newline = '\0';
-        
-        char *trimmed_line = trim_string(line);
-        
-        /* Pular linhas vazias */
-        if (is_empty_line(trimmed_line)) {
+/**
+ * @brief Núcleo do parser DIMACS, comum a arquivos mapeados e streams
+ * @param parser Parser (a fórmula já existe se a linha "p" foi lida antes)
+ * @param in Entrada (em memória ou com buffer reabastecível)
+ * @return Código de resultado da varredura
+ *
+ * Lê por tokens e não por linhas: cláusulas podem se estender por várias
+ * linhas, não há limite de tamanho de linha e o literal 0 é o único
+ * terminador de cláusula. Comentários e a linha "p" só são
+ * reconhecidos no início de uma linha; '%' encerra a entrada (formato SATLIB)
+ * e fica em in->pos, para que o chamador saiba que a varredura parou antes.
+ */
+static parse_result_t scan_dimacs(cnf_parser_t *parser, dimacs_input_t *in) {
+    parse_stats_t *stats = &parser->stats;
+    literal_vector_t clause = {0};      /* Reutilizado por todas as cláusulas */
+    line_kind_t line = LINE_EMPTY;
+    bool pending_line = false;          /* Linha corrente ainda não contabilizada */
+    parse_result_t status = PARSE_OK;
+
+    while (status == PARSE_OK && (in->pos < in->end || input_refill(in))) {
+        char c = *in->pos;
+
+        if (!pending_line) {
+            parser->info.line_number++;
+            pending_line = true;
+        }
+        if (c == '\n') {
+            count_line(stats, line);
+            line = LINE_EMPTY;
+            pending_line = false;
+            in->pos++;
             continue;
         }
-        
-        /* Processar comentários */
-        if (is_comment_line(trimmed_line)) {
-            if (parser->verbose) {
-                log_debug("Comentário na linha %d: %s", parser->info.line_number, trimmed_line);
-            }
+        if (is_blank(c)) {
+            in->pos++;
             continue;
         }
-        
-        /* Processar linha de definição do problema */
-        if (is_problem_line(trimmed_line)) {
-            if (problem_line_found) {
-                snprintf(parser->info.error_message, sizeof(parser->info.error_message),
-                        "Múltiplas linhas de definição encontradas");
-                return PARSE_ERROR_INVALID_PROBLEM_LINE;
-            }
-            
-            int num_vars, num_clauses;
-            parse_result_t result = parse_problem_line(trimmed_line, &num_vars, &num_clauses);
-            if (result != PARSE_OK) {
-                snprintf(parser->info.error_message, sizeof(parser->info.error_message),
-                        "Linha de definição inválida: %s", trimmed_line);
-                return result;
+
+        if (line == LINE_EMPTY) {
+            if (c == 'c') {
+                line = LINE_COMMENT;
+                const char *newline;
+                while (!(newline = memchr(in->pos, '\n', (size_t)(in->end - in->pos)))) {
+                    in->pos = in->end;
+                    if (!input_refill(in)) break;
+                }
+                if (newline) in->pos = newline;
+                continue;
             }
-            
-            parser->info.max_variables = num_vars;
-            parser->info.expected_clauses = num_clauses;
-            problem_line_found = true;
-            
-            /* Criar a fórmula CNF */
-            parser->formula = cnf_create(num_vars);
-            if (!parser->formula) {
-                return PARSE_ERROR_MEMORY;
+            if (c == 'p') {
+                line = LINE_PROBLEM;
+                status = scan_problem_line(parser, in);
+                continue;
             }
-            
-            if (parser->verbose) {
-                log_info("Problema: %d variáveis, %d cláusulas", num_vars, num_clauses);
+            if (c == '%') {
+                break;
             }
-            
+            line = LINE_CLAUSE;
+        }
+
+        if (!parser->formula) {
+            status = parse_error(parser, PARSE_ERROR_NO_PROBLEM_LINE,
+                                 "Linha de definição 'p cnf' não encontrada antes das cláusulas");
+            break;
+        }
+
+        int literal = 0;
+        status = scan_literal(parser, in, &literal);
+        if (status != PARSE_OK) break;
+
+        if (literal == 0) {
+            status = finish_clause(parser, &clause);
             continue;
         }
-        
-        /* Processar cláusulas */
-        if (!problem_line_found) {
-            snprintf(parser->info.error_message, sizeof(parser->info.error_message),
-                    "Linha de definição 'p cnf' não encontrada antes das cláusulas");
-            return PARSE_ERROR_NO_PROBLEM_LINE;
+
+        if (abs(literal) > parser->info.max_variables) {
+            status = parse_error(parser, PARSE_ERROR_VARIABLE_OUT_OF_RANGE,
+                                 "Variável %d fora do intervalo na linha %d",
+                                 abs(literal), parser->info.line_number);
+            break;
         }
-        
-        clause_t *clause = clause_create(8);
-        if (!clause) return PARSE_ERROR_MEMORY;
-        
-        parse_result_t result = parse_clause_line(trimmed_line, clause, parser->info.max_variables);
-        if (result != PARSE_OK) {
-            clause_destroy(clause);
-            snprintf(parser->info.error_message, sizeof(parser->info.error_message),
-                    "Cláusula inválida: %s", trimmed_line);
-            return result;
+
+        /* Duplicatas e tautologias são tratadas de uma vez ao fim da cláusula */
+        if (!literal_vector_push(&clause, literal)) {
+            status = PARSE_ERROR_MEMORY;
         }
-        
-        /* Verificar se cláusula não está vazia (a não ser que permitido) */
-        if (clause->size == 0) {
-            clause_destroy(clause);
-            if (parser->strict_mode) {
-                snprintf(parser->info.error_message, sizeof(parser->info.error_message),
-                        "Cláusula vazia não permitida no modo rigoroso");
-                return PARSE_ERROR_INVALID_CLAUSE;
+    }
+
+    if (pending_line) count_line(stats, line);
+    if (status == PARSE_OK && clause.size > 0) {
+        status = parse_error(parser, PARSE_ERROR_CLAUSE_NOT_TERMINATED,
+                             "Última cláusula não terminada com 0");
+    }
+    literal_vector_dispose(&clause);
+    stats->bytes += in->bytes;
+    return status;
+}
+
+/* Validações finais comuns aos caminhos serial e paralelo */
+static parse_result_t finish_parse(cnf_parser_t *parser, parse_result_t status, timer_t *timer) {
+    parse_stats_t *stats = &parser->stats;
+
+    timer_stop(timer);
+    stats->parse_time = timer_elapsed(timer);
+    if (stats->parse_time > 0) {
+        stats->throughput = (double)stats->bytes / (1024.0 * 1024.0) / stats->parse_time;
+    }
+
+    if (status != PARSE_OK) {
+        return status;
+    }
+
+    if (!parser->formula) {
+        return parse_error(parser, PARSE_ERROR_NO_PROBLEM_LINE,
+                           "Linha de definição 'p cnf' não encontrada");
+    }
+
+    /* Verificar número de cláusulas */
+    if (parser->strict_mode && parser->info.parsed_clauses != parser->info.expected_clauses) {
+        return parse_error(parser, PARSE_ERROR_INVALID_FORMAT,
+                           "Esperadas %d cláusulas, encontradas %d",
+                           parser->info.expected_clauses, parser->info.parsed_clauses);
+    }
+
+    if (parser->verbose) {
+        log_info("Parsing concluído: %d cláusulas em %.6f segundos",
+                parser->info.parsed_clauses, stats->parse_time);
+    }
+
+    return PARSE_OK;
+}
+
+static parse_result_t parse_dimacs(cnf_parser_t *parser, dimacs_input_t *in) {
+    timer_t timer;
+    timer_start(&timer);
+    parse_result_t status = scan_dimacs(parser, in);
+    return finish_parse(parser, status, &timer);
+}
+
+/* ========== Parsing Paralelo ========== */
+
+#define PARALLEL_MIN_CHUNK (1024 * 1024)  /* Bytes mínimos por thread */
+
+/* Trecho do corpo da fórmula processado por uma thread */
+typedef struct {
+    cnf_parser_t parser;       // Parser local, com fórmula própria
+    const char *begin;
+    const char *end;
+    parse_result_t status;
+    bool stopped;              // Encontrou '%': trechos seguintes são ignorados
+} parse_chunk_t;
+
+/**
+ * @brief Localiza o fim do cabeçalho (comentários e linha "p")
+ * @return Início da linha seguinte à linha "p", ou NULL se algo diferente
+ *         de comentário ou linha vazia aparece antes dela
+ */
+static const char* find_body(const char *pos, const char *end) {
+    while (pos < end) {
+        const char *newline = memchr(pos, '\n', (size_t)(end - pos));
+        const char *line_end = newline ? newline : end;
+        const char *p = pos;
+        while (p < line_end && is_blank(*p)) p++;
+
+        if (p < line_end && *p == 'p') {
+            return newline ? newline + 1 : end;
+        }
+        if (p < line_end && *p != 'c') {
+            return NULL;
+        }
+        pos = newline ? newline + 1 : end;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Avança pos até o início de uma linha que sucede o fim de uma cláusula
+ * @return Primeira posição >= pos logo após uma linha (não comentário) cujo
+ *         último token é o terminador 0, ou end
+ *
+ * Cortar só nesses pontos garante que nenhuma cláusula fica dividida
+ * entre duas threads, mesmo com cláusulas de várias linhas.
+ */
+static const char* find_clause_boundary(const char *pos, const char *begin, const char *end) {
+    if (pos <= begin) return begin;
+
+    /* Recuar até o início da linha corrente */
+    while (pos > begin && pos[-1] != '\n') pos--;
+
+    while (pos < end) {
+        const char *newline = memchr(pos, '\n', (size_t)(end - pos));
+        if (!newline) return end;
+
+        const char *first = pos;
+        while (first < newline && is_blank(*first)) first++;
+        const char *last = newline;
+        while (last > first && is_blank(last[-1])) last--;
+
+        bool terminated = last > first && last[-1] == '0' &&
+                          (last - 1 == first || is_blank(last[-2]));
+        pos = newline + 1;
+        if (terminated && *first != 'c' && *first != '%') {
+            return pos;
+        }
+    }
+    return end;
+}
+
+static void parse_chunk_task(void *context, size_t index) {
+    parse_chunk_t *chunk = &((parse_chunk_t*)context)[index];
+    if (!chunk->parser.formula || !chunk->parser.normalizer.marks) {
+        chunk->status = PARSE_ERROR_MEMORY;
+        return;
+    }
+
+    dimacs_input_t input;
+    input_init_memory(&input, chunk->begin, (size_t)(chunk->end - chunk->begin));
+    chunk->status = scan_dimacs(&chunk->parser, &input);
+    chunk->stopped = chunk->status == PARSE_OK && input.pos < input.end;
+}
+
+/**
+ * @brief Parsing paralelo de um conteúdo em memória (arquivo mapeado)
+ * @param parser Parser já reiniciado
+ * @param data Conteúdo completo
+ * @param size Tamanho em bytes
+ * @param threads Número de threads desejado
+ * @return Código de resultado do parsing
+ *
+ * O cabeçalho é lido serialmente; o corpo é dividido em fronteiras de
+ * cláusula e cada thread preenche a arena de uma fórmula local. As
+ * fórmulas locais são concatenadas na ordem original do arquivo
+ * (cnf_append_formula). Se algum trecho falhar, o arquivo é relido
+ * serialmente, o que reproduz exatamente a mensagem e a linha do erro.
+ */
+static parse_result_t parse_dimacs_parallel(cnf_parser_t *parser, const char *data, size_t size,
+                                            size_t threads) {
+    const char *end = data + size;
+    const char *body = find_body(data, end);
+    size_t body_size = body ? (size_t)(end - body) : 0;
+    if (threads > body_size / PARALLEL_MIN_CHUNK) {
+        threads = body_size / PARALLEL_MIN_CHUNK;
+    }
+
+    dimacs_input_t input;
+    if (threads < 2) {
+        input_init_memory(&input, data, size);
+        return parse_dimacs(parser, &input);
+    }
+
+    timer_t timer;
+    timer_start(&timer);
+
+    /* Cabeçalho: cria a fórmula com o número de variáveis declarado */
+    input_init_memory(&input, data, (size_t)(body - data));
+    parse_result_t status = scan_dimacs(parser, &input);
+    if (status != PARSE_OK || !parser->formula) {
+        return finish_parse(parser, status, &timer);
+    }
+
+    parse_chunk_t *chunks = safe_calloc(threads, sizeof(parse_chunk_t));
+    const char *begin = body;
+    for (size_t i = 0; i < threads; i++) {
+        parse_chunk_t *chunk = &chunks[i];
+        chunk->begin = begin;
+        chunk->end = i + 1 == threads ? end
+                   : find_clause_boundary(body + body_size / threads * (i + 1), begin, end);
+        begin = chunk->end;
+
+        parse_stats_init(&chunk->parser.stats);
+        chunk->parser.strict_mode = parser->strict_mode;
+        chunk->parser.info.max_variables = parser->info.max_variables;
+        chunk->parser.formula = cnf_create(parser->info.max_variables);
+        clause_normalizer_init(&chunk->parser.normalizer, parser->info.max_variables,
+                               parser->sort_literals);
+    }
+
+    io_parallel_for(threads, parse_chunk_task, chunks);
+
+    /* Reservar a arena final de uma vez e concatenar na ordem do arquivo */
+    size_t total_words = 0;
+    for (size_t i = 0; i < threads && status == PARSE_OK; i++) {
+        status = chunks[i].status;
+        total_words += chunks[i].parser.formula ? chunks[i].parser.formula->arena.size : 0;
+        if (chunks[i].stopped) break;
+    }
+    if (status == PARSE_OK && !clause_arena_reserve(&parser->formula->arena, total_words)) {
+        status = PARSE_ERROR_MEMORY;
+    }
+
+    for (size_t i = 0; i < threads && status == PARSE_OK; i++) {
+        cnf_parser_t *local = &chunks[i].parser;
+        if (!cnf_append_formula(parser->formula, local->formula)) {
+            status = PARSE_ERROR_MEMORY;
+            break;
+        }
+        parser->info.parsed_clauses += local->info.parsed_clauses;
+        parser->info.line_number += local->info.line_number;
+        parser->stats.total_lines += local->stats.total_lines;
+        parser->stats.empty_lines += local->stats.empty_lines;
+        parser->stats.comment_lines += local->stats.comment_lines;
+        parser->stats.problem_lines += local->stats.problem_lines;
+        parser->stats.clause_lines += local->stats.clause_lines;
+        if (chunks[i].stopped) break;
+    }
+    parser->stats.bytes = size;
+
+    for (size_t i = 0; i < threads; i++) {
+        if (chunks[i].parser.formula) cnf_destroy(chunks[i].parser.formula);
+        clause_normalizer_dispose(&chunks[i].parser.normalizer);
+    }
+    free(chunks);
+
+    if (status != PARSE_OK) {
+        /* Releitura serial para reportar o erro com a linha correta */
+        parser_reset(parser);
+        input_init_memory(&input, data, size);
+        return parse_dimacs(parser, &input);
+    }
+
+    if (parser->verbose) {
+        log_info("Parsing paralelo com %zu threads", threads);
+    }
+    return finish_parse(parser, status, &timer);
+}
+
+/**
+ * @brief Faz o parsing de um arquivo compactado, descompactando em paralelo
+ * @param parser Parser
+ * @param filename Caminho do arquivo
+ * @param compression Formato detectado pelos bytes mágicos
+ * @return Código de resultado; erro de descompressão prevalece sobre o do parsing
+ */
+static parse_result_t parse_compressed_file(cnf_parser_t *parser, const char *filename,
+                                            io_compression_t compression) {
+    parser_reset(parser);
+    
+    io_decoder_t *decoder = io_decoder_open(filename, compression);
+    if (!decoder) {
+        return parse_error(parser, PARSE_ERROR_FILE_NOT_FOUND,
+                           "Não foi possível abrir o arquivo compactado: %s", filename);
+    }
+    
+    char *buffer = safe_malloc(PARSER_BUFFER_SIZE);
+    dimacs_input_t input;
+    input_init_stream(&input, buffer, PARSER_BUFFER_SIZE, io_decoder_read, decoder);
+    
+    parse_result_t result = parse_dimacs(parser, &input);
+    free(buffer);
+    
+    if (!io_decoder_close(decoder)) {
+        return parse_error(parser, PARSE_ERROR_INVALID_FORMAT,
+                           "Arquivo %s corrompido ou truncado", io_compression_to_string(compression));
+    }
+    return result;
+}
+
+/* ========== Formato Binário ========== */
+
+/*
+ * Layout (little-endian), cabeçalho de 56 bytes:
+ *   0  "SATB"            magia
+ *   4  uint32 versão     BINARY_VERSION
+ *   8  uint32 flags      BINARY_FLAG_*
+ *  12  uint32 variáveis
+ *  16  uint64 cláusulas
+ *  24  uint64 literais
+ *  32  uint64 bytes da seção de tamanhos
+ *  40  uint64 bytes da seção de literais
+ *  48  uint64 checksum   FNV-1a dos bytes 0..47 e das duas seções
+ *                        (se BINARY_FLAG_CHECKSUM)
+ * Seção de tamanhos: um varint por cláusula, completada com zeros até
+ * múltiplo de 4. Seção de literais: int32 brutos, alinhados para irem
+ * direto do mapeamento para a arena; com BINARY_FLAG_VARINT, varints
+ * zigzag (arquivo menor, decodificação literal a literal).
+ */
+
+#define BINARY_MAGIC         "SATB"
+#define BINARY_VERSION       1u
+#define BINARY_HEADER_SIZE   56
+#define BINARY_CHECKSUM_AT   48
+#define BINARY_FLAG_CHECKSUM 0x1u
+#define BINARY_FLAG_VARINT   0x2u
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+} byte_buffer_t;
+
+static void byte_buffer_push(byte_buffer_t *buffer, uint8_t byte) {
+    if (buffer->size == buffer->capacity) {
+        buffer->capacity = buffer->capacity > 0 ? buffer->capacity * 2 : 4096;
+        buffer->data = safe_realloc(buffer->data, buffer->capacity);
+    }
+    buffer->data[buffer->size++] = byte;
+}
+
+static void byte_buffer_push_varint(byte_buffer_t *buffer, uint32_t value) {
+    while (value >= 0x80) {
+        byte_buffer_push(buffer, (uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    byte_buffer_push(buffer, (uint8_t)value);
+}
+
+static void byte_buffer_push_u32(byte_buffer_t *buffer, uint32_t value) {
+    for (int i = 0; i < 4; i++) byte_buffer_push(buffer, (uint8_t)(value >> (8 * i)));
+}
+
+static void byte_buffer_push_u64(byte_buffer_t *buffer, uint64_t value) {
+    for (int i = 0; i < 8; i++) byte_buffer_push(buffer, (uint8_t)(value >> (8 * i)));
+}
+
+static uint32_t read_u32(const uint8_t *data) {
+    return (uint32_t)data[0] | (uint32_t)data[1] << 8 |
+           (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24;
+}
+
+static uint64_t read_u64(const uint8_t *data) {
+    return (uint64_t)read_u32(data) | (uint64_t)read_u32(data + 4) << 32;
+}
+
+/* Lê um varint de [*pos, end); false se truncado ou maior que 32 bits */
+static bool read_varint(const uint8_t **pos, const uint8_t *end, uint32_t *value) {
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35 && *pos < end; shift += 7) {
+        uint8_t byte = *(*pos)++;
+        result |= (uint32_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t zigzag_encode(literal_t literal) {
+    return ((uint32_t)literal << 1) ^ (uint32_t)-(literal < 0);
+}
+
+static literal_t zigzag_decode(uint32_t value) {
+    return (literal_t)(value >> 1) ^ -(literal_t)(value & 1);
+}
+
+static uint64_t fnv1a(uint64_t hash, const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+#define FNV_OFFSET_BASIS 14695981039346656037ull
+
+/**
+ * @brief Checksum do arquivo: cabeçalho sem o próprio campo, depois o conteúdo
+ */
+static uint64_t binary_checksum(const uint8_t *header, const uint8_t *payload, size_t payload_size) {
+    return fnv1a(fnv1a(FNV_OFFSET_BASIS, header, BINARY_CHECKSUM_AT), payload, payload_size);
+}
+
+static bool host_is_little_endian(void) {
+    const uint16_t probe = 1;
+    return *(const uint8_t*)&probe == 1;
+}
+
+static bool is_binary_cnf(const char *data, size_t size) {
+    return size >= BINARY_HEADER_SIZE && memcmp(data, BINARY_MAGIC, 4) == 0;
+}
+
+/**
+ * @brief Carrega uma fórmula no formato binário a partir de um arquivo mapeado
+ * @param parser Parser já reiniciado
+ * @param data Conteúdo do arquivo
+ * @param size Tamanho em bytes
+ * @return PARSE_OK ou PARSE_ERROR_INVALID_FORMAT/VARIABLE_OUT_OF_RANGE
+ *
+ * Com literais brutos, cada cláusula é copiada do mapeamento para a arena
+ * com um único memcpy; os literais são conferidos contra o número de
+ * variáveis e, como no texto, duplicatas saem e tautologias são ignoradas.
+ * Só as cláusulas que a normalização altera passam por uma cópia.
+ */
+static parse_result_t load_binary(cnf_parser_t *parser, const char *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t*)data;
+    timer_t timer;
+    timer_start(&timer);
+
+    uint32_t version = read_u32(bytes + 4);
+    uint32_t flags = read_u32(bytes + 8);
+    uint32_t num_vars = read_u32(bytes + 12);
+    uint64_t num_clauses = read_u64(bytes + 16);
+    uint64_t num_literals = read_u64(bytes + 24);
+    uint64_t sizes_bytes = read_u64(bytes + 32);
+    uint64_t literal_bytes = read_u64(bytes + 40);
+    uint64_t checksum = read_u64(bytes + BINARY_CHECKSUM_AT);
+    bool varint = (flags & BINARY_FLAG_VARINT) != 0;
+
+    if (version != BINARY_VERSION) {
+        return parse_error(parser, PARSE_ERROR_INVALID_FORMAT,
+                           "Versão do formato binário não suportada: %u", version);
+    }
+    uint64_t padded_sizes = (sizes_bytes + 3) & ~(uint64_t)3;
+    /* Cada cláusula ocupa ao menos um byte de tamanho e cada literal ao
+     * menos um byte, o que limita as contagens antes de qualquer alocação */
+    if (num_vars == 0 || num_vars > INT32_MAX || num_clauses > INT32_MAX ||
+        padded_sizes > size || literal_bytes > size ||
+        num_clauses > sizes_bytes || num_literals > literal_bytes ||
+        BINARY_HEADER_SIZE + padded_sizes + literal_bytes != size ||
+        (!varint && literal_bytes != num_literals * sizeof(literal_t))) {
+        return parse_error(parser, PARSE_ERROR_INVALID_FORMAT,
+                           "Cabeçalho binário inconsistente com o tamanho do arquivo");
+    }
+    if ((flags & BINARY_FLAG_CHECKSUM) &&
+        binary_checksum(bytes, bytes + BINARY_HEADER_SIZE, size - BINARY_HEADER_SIZE) != checksum) {
+        return parse_error(parser, PARSE_ERROR_INVALID_FORMAT, "Checksum do arquivo binário não confere");
+    }
+
+    parser->info.max_variables = (int)num_vars;
+    parser->info.expected_clauses = (int)num_clauses;
+    parser->formula = cnf_create((variable_t)num_vars);
+    if (!parser->formula ||
+        !clause_normalizer_init(&parser->normalizer, (variable_t)num_vars, parser->sort_literals) ||
+        !clause_arena_reserve(&parser->formula->arena,
+                              num_clauses * CLAUSE_HEADER_WORDS + num_literals + num_clauses)) {
+        return PARSE_ERROR_MEMORY;
+    }
+
+    const uint8_t *size_pos = bytes + BINARY_HEADER_SIZE;
+    const uint8_t *size_end = size_pos + sizes_bytes;
+    const uint8_t *literal_pos = bytes + BINARY_HEADER_SIZE + padded_sizes;
+    const uint8_t *literal_end = literal_pos + literal_bytes;
+    bool direct = !varint && host_is_little_endian();
+    literal_vector_t clause = {0};
+    parse_result_t status = PARSE_OK;
+
+    for (uint64_t i = 0; i < num_clauses && status == PARSE_OK; i++) {
+        uint32_t clause_size;
+        if (!read_varint(&size_pos, size_end, &clause_size) ||
+            (!varint && clause_size > (size_t)(literal_end - literal_pos) / sizeof(literal_t))) {
+            status = parse_error(parser, PARSE_ERROR_INVALID_FORMAT,
+                                 "Cláusula %llu truncada no arquivo binário", (unsigned long long)i);
+            break;
+        }
+
+        const literal_t *literals;
+        if (direct) {
+            literals = (const literal_t*)(const void*)literal_pos;
+            literal_pos += clause_size * sizeof(literal_t);
+        } else {
+            clause.size = 0;
+            for (uint32_t j = 0; j < clause_size && status == PARSE_OK; j++) {
+                uint32_t value;
+                literal_t literal;
+                if (varint) {
+                    if (!read_varint(&literal_pos, literal_end, &value)) break;
+                    literal = zigzag_decode(value);
+                } else {
+                    literal = (literal_t)read_u32(literal_pos);
+                    literal_pos += sizeof(literal_t);
+                }
+                if (!literal_vector_push(&clause, literal)) {
+                    status = PARSE_ERROR_MEMORY;
+                }
             }
-            continue; /* Ignorar cláusula vazia */
+            if (status != PARSE_OK) break;
+            if (clause.size != clause_size) {
+                status = parse_error(parser, PARSE_ERROR_INVALID_FORMAT,
+                                     "Cláusula %llu truncada no arquivo binário", (unsigned long long)i);
+                break;
+            }
+            literals = clause.literals;
         }
 
-        /* Ignorar tautologias explicitamente (não alteram a satisfatibilidade) */
-        if (clause_is_tautology(clause)) {
+        /* Sem abs(): -INT32_MIN não é representável */
+        for (uint32_t j = 0; j < clause_size; j++) {
+            if (literals[j] == 0 || literals[j] < -(literal_t)num_vars ||
+                literals[j] > (literal_t)num_vars) {
+                status = parse_error(parser, PARSE_ERROR_VARIABLE_OUT_OF_RANGE,
+                                     "Literal %d fora do intervalo na cláusula %llu",
+                                     literals[j], (unsigned long long)i);
+                break;
+            }
+        }
+        if (status != PARSE_OK) break;
+
+        /* Literais mapeados não podem ser alterados: copiar só se a normalização mudaria algo */
+        size_t normalized_size = clause_size;
+        if (direct && (parser->sort_literals ||
+                       !clause_is_normalized(&parser->normalizer, literals, clause_size))) {
+            clause.size = 0;
+            for (uint32_t j = 0; j < clause_size && status == PARSE_OK; j++) {
+                if (!literal_vector_push(&clause, literals[j])) {
+                    status = PARSE_ERROR_MEMORY;
+                }
+            }
+            if (status != PARSE_OK) break;
+            literals = clause.literals;
+        }
+        if (literals == clause.literals &&
+            !clause_normalize(&parser->normalizer, clause.literals, &normalized_size)) {
             if (parser->verbose) {
-                log_debug("Ignorando cláusula tautológica na linha %d", parser->info.line_number);
+                log_debug("Ignorando cláusula tautológica %llu", (unsigned long long)i);
             }
-            clause_destroy(clause);
             continue;
         }
-        
-        /* Adicionar cláusula à fórmula */
-        if (!cnf_add_clause(parser->formula, clause)) {
-            clause_destroy(clause);
-            return PARSE_ERROR_MEMORY;
+
+        if (cnf_add_clause_literals(parser->formula, literals, normalized_size, false) == CLAUSE_REF_UNDEF) {
+            status = PARSE_ERROR_MEMORY;
+            break;
         }
-        
         parser->info.parsed_clauses++;
-        
-        if (parser->verbose && parser->info.parsed_clauses % 1000 == 0) {
-            log_debug("Processadas %d cláusulas...", parser->info.parsed_clauses);
-        }
     }
+    literal_vector_dispose(&clause);
+
+    parser->stats.bytes = size;
+    return finish_parse(parser, status, &timer);
+}
+
+/* ========== Funções de Parsing ========== */
+
+/**
+ * @brief Faz o parsing de um arquivo DIMACS, compactado ou binário
+ * @param parser Parser
+ * @param filename Caminho do arquivo; "-" lê da entrada padrão
+ * @return Código de resultado do parsing
+ *
+ * Entrada padrão, FIFOs e outros arquivos não regulares são lidos uma
+ * única vez pelo caminho de streaming, à medida que o produtor escreve.
+ */
+parse_result_t parser_parse_file(cnf_parser_t *parser, const char *filename) {
+    if (!parser || !filename) return PARSE_ERROR_INVALID_FORMAT;
     
-    timer_stop(&timer);
+    if (strcmp(filename, "-") == 0) {
+        if (parser->verbose) {
+            log_info("Parsing entrada padrão");
+        }
+        return parser_parse_stream(parser, stdin);
+    }
     
-    if (!problem_line_found) {
+    io_path_kind_t kind = io_path_kind(filename);
+    if (kind == IO_PATH_MISSING) {
         snprintf(parser->info.error_message, sizeof(parser->info.error_message),
-                "Linha de definição 'p cnf' não encontrada");
-        return PARSE_ERROR_NO_PROBLEM_LINE;
+                "Arquivo não encontrado: %s", filename);
+        return PARSE_ERROR_FILE_NOT_FOUND;
     }
     
-    /* Verificar número de cláusulas */
-    if (parser->strict_mode && parser->info.parsed_clauses != parser->info.expected_clauses) {
+    /* Arquivos compactados: descompressão em outra thread, direto para o scanner */
+    io_compression_t compression = kind == IO_PATH_REGULAR
+                                 ? io_detect_compression(filename) : IO_COMPRESSION_NONE;
+    if (compression != IO_COMPRESSION_NONE) {
+        if (parser->verbose) {
+            log_info("Parsing arquivo (%s): %s", io_compression_to_string(compression), filename);
+        }
+        return parse_compressed_file(parser, filename, compression);
+    }
+    
+    /* Caminho rápido: arquivo regular mapeado em memória, sem cópias */
+    io_mapping_t mapping;
+    if (kind == IO_PATH_REGULAR && io_map_file(filename, &mapping)) {
+        if (parser->verbose) {
+            log_info("Parsing arquivo (mmap): %s", filename);
+        }
+        
+        parse_result_t result = parser_parse_buffer(parser, mapping.data, mapping.size);
+        io_unmap(&mapping);
+        
+        return result;
+    }
+    
+    FILE *file = fopen(filename, "r");
+    if (!file) {
         snprintf(parser->info.error_message, sizeof(parser->info.error_message),
-                "Esperadas %d cláusulas, encontradas %d", 
-                parser->info.expected_clauses, parser->info.parsed_clauses);
-        return PARSE_ERROR_INVALID_FORMAT;
+                "Não foi possível abrir o arquivo: %s", filename);
+        return PARSE_ERROR_FILE_NOT_FOUND;
     }
     
     if (parser->verbose) {
-        log_info("Parsing concluído: %d cláusulas em %.6f segundos", 
-                parser->info.parsed_clauses, timer_elapsed(&timer));
+        log_info("Parsing arquivo: %s", filename);
     }
     
-    return PARSE_OK;
+    parse_result_t result = parser_parse_stream(parser, file);
+    fclose(file);
+    
+    return result;
+}
+
+parse_result_t parser_parse_string(cnf_parser_t *parser, const char *content) {
+    if (!parser || !content) return PARSE_ERROR_INVALID_FORMAT;
+    
+    return parser_parse_buffer(parser, content, strlen(content));
+}
+
+/**
+ * @brief Faz o parsing de um conteúdo já em memória, sem cópias
+ * @param parser Parser
+ * @param data Conteúdo (DIMACS ou formato binário); não precisa terminar em '\0'
+ * @param size Tamanho em bytes
+ * @return Código de resultado do parsing
+ *
+ * Caminho comum a strings, arquivos mapeados e entradas já lidas para
+ * um buffer: o scanner lê direto de data, que só precisa continuar
+ * válido durante a chamada.
+ */
+parse_result_t parser_parse_buffer(cnf_parser_t *parser, const char *data, size_t size) {
+    if (!parser || (!data && size > 0)) return PARSE_ERROR_INVALID_FORMAT;
+    if (!data) data = "";
+    
+    parser_reset(parser);
+    
+    if (is_binary_cnf(data, size)) {
+        return load_binary(parser, data, size);
+    }
+    size_t threads = parser->parse_threads > 0 ? parser->parse_threads : io_cpu_count();
+    return parse_dimacs_parallel(parser, data, size, threads);
+}
+
+parse_result_t parser_parse_stream(cnf_parser_t *parser, FILE *stream) {
+    if (!parser || !stream) return PARSE_ERROR_INVALID_FORMAT;
+    
+    parser_reset(parser);
+    
+    char *buffer = safe_malloc(PARSER_BUFFER_SIZE);
+    dimacs_input_t input;
+    input_init_stream(&input, buffer, PARSER_BUFFER_SIZE, read_stream, stream);
+    
+    parse_result_t result = parse_dimacs(parser, &input);
+    free(buffer);
+    
+    return result;
 }
 
 /* ========== Funções de Parsing de Baixo Nível ========== */
@@ -293,8 +1092,19 @@ parse_result_t parse_problem_line(const char *line, int *num_vars, int *num_clau
     return PARSE_OK;
 }
 
-parse_result_t parse_clause_line(const char *line, clause_t *clause, int max_variables) {
-    if (!line || !clause) return PARSE_ERROR_INVALID_FORMAT;
+/**
+ * @brief Lê uma cláusula DIMACS completa de uma linha, já normalizada
+ * @param line Linha terminada pelo literal 0
+ * @param clause Saída: literais sem duplicatas; vazia se a cláusula é tautológica
+ * @param normalizer Normalizador; seu número de variáveis limita os literais
+ * @return PARSE_OK ou o erro correspondente
+ *
+ * Como no scanner, a cláusula resultante pode ir direto para
+ * cnf_add_clause_literals (e uma cláusula vazia é ignorada).
+ */
+parse_result_t parse_clause_line(const char *line, literal_vector_t *clause,
+                                 clause_normalizer_t *normalizer) {
+    if (!line || !clause || !normalizer || !normalizer->marks) return PARSE_ERROR_INVALID_FORMAT;
     
     char *line_copy = string_duplicate(line);
     if (!line_copy) return PARSE_ERROR_MEMORY;
@@ -314,12 +1124,13 @@ parse_result_t parse_clause_line(const char *line, clause_t *clause, int max_var
             break;
         }
         
-        if (!is_valid_literal(literal, max_variables)) {
+        if (!is_valid_literal(literal, normalizer->num_variables)) {
             free(line_copy);
             return PARSE_ERROR_VARIABLE_OUT_OF_RANGE;
         }
         
-        if (!clause_add_literal(clause, literal)) {
+        /* Duplicatas e tautologias são tratadas de uma vez ao fim da cláusula */
+        if (!literal_vector_push(clause, literal)) {
             free(line_copy);
             return PARSE_ERROR_MEMORY;
         }
@@ -333,6 +1144,9 @@ parse_result_t parse_clause_line(const char *line, clause_t *clause, int max_var
         return PARSE_ERROR_CLAUSE_NOT_TERMINATED;
     }
     
+    if (!clause_normalize(normalizer, clause->literals, &clause->size)) {
+        clause->size = 0;
+    }
     return PARSE_OK;
 }
 
@@ -423,6 +1237,27 @@ void parser_print_info(const parser_info_t *info) {
     }
 }
 
+/* ========== Estatísticas de Parsing ========== */
+
+void parse_stats_init(parse_stats_t *stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+}
+
+void parse_stats_print(const parse_stats_t *stats) {
+    if (!stats) return;
+    
+    printf(COLOR_BLUE "=== Estatísticas de Parsing ===" COLOR_RESET "\n");
+    printf("Linhas: %zu (cláusulas: %zu, comentários: %zu, vazias: %zu, problema: %zu)\n",
+           stats->total_lines, stats->clause_lines, stats->comment_lines,
+           stats->empty_lines, stats->problem_lines);
+    printf("Bytes lidos: %zu\n", stats->bytes);
+    printf("Tempo de parsing: %.6f s\n", stats->parse_time);
+    if (stats->throughput > 0) {
+        printf("Vazão: %.2f MB/s\n", stats->throughput);
+    }
+}
+
 /* ========== Funções de Escrita (Opcional) ========== */
 
 bool parser_write_cnf_file(const cnf_formula_t *cnf, const char *filename) {
@@ -442,11 +1277,12 @@ bool parser_write_cnf_stream(const cnf_formula_t *cnf, FILE *stream) {
     
     /* Escrever header */
     fprintf(stream, "c Arquivo CNF gerado pelo SAT Solver\n");
-    fprintf(stream, "p cnf %d %zu\n", cnf->num_variables, cnf->clauses.count);
+    fprintf(stream, "p cnf %d %zu\n", cnf->num_variables, cnf->clauses.count - cnf->learnt_count);
     
-    /* Escrever cláusulas */
+    /* Escrever cláusulas (aprendidas são implicadas e ficam de fora) */
     for (size_t i = 0; i < cnf->clauses.count; i++) {
-        const clause_t *clause = &cnf->clauses.clauses[i];
+        const clause_t *clause = cnf_clause(cnf, cnf->clauses.refs[i]);
+        if (clause->learnt) continue;
         
         for (size_t j = 0; j < clause->size; j++) {
             fprintf(stream, "%d ", clause->literals[j]);
@@ -455,4 +1291,68 @@ bool parser_write_cnf_stream(const cnf_formula_t *cnf, FILE *stream) {
     }
     
     return true;
-}
\ No newline at end of file
+}
+/**
+ * @brief Salva a fórmula (cláusulas originais) no formato binário
+ * @param cnf Fórmula CNF
+ * @param filename Arquivo de saída
+ * @param compact Se true, literais em varint zigzag (menor, carga mais lenta);
+ *                senão int32 brutos, copiados direto para a arena na carga
+ * @return false se o arquivo não pôde ser escrito
+ *
+ * O arquivo é reconhecido automaticamente por parser_parse_file.
+ */
+bool parser_write_binary(const cnf_formula_t *cnf, const char *filename, bool compact) {
+    if (!cnf || !filename) return false;
+    
+    byte_buffer_t payload = {0};
+    uint64_t num_clauses = 0, num_literals = 0;
+    
+    /* Seção de tamanhos, completada até múltiplo de 4 */
+    for (size_t i = 0; i < cnf->clauses.count; i++) {
+        const clause_t *clause = cnf_clause(cnf, cnf->clauses.refs[i]);
+        if (clause->learnt || clause->deleted) continue;
+        byte_buffer_push_varint(&payload, clause->size);
+        num_clauses++;
+        num_literals += clause->size;
+    }
+    uint64_t sizes_bytes = payload.size;
+    while (payload.size % 4 != 0) byte_buffer_push(&payload, 0);
+    
+    /* Seção de literais */
+    for (size_t i = 0; i < cnf->clauses.count; i++) {
+        const clause_t *clause = cnf_clause(cnf, cnf->clauses.refs[i]);
+        if (clause->learnt || clause->deleted) continue;
+        for (size_t j = 0; j < clause->size; j++) {
+            if (compact) {
+                byte_buffer_push_varint(&payload, zigzag_encode(clause->literals[j]));
+            } else {
+                byte_buffer_push_u32(&payload, (uint32_t)clause->literals[j]);
+            }
+        }
+    }
+    uint64_t padded_sizes = (sizes_bytes + 3) & ~(uint64_t)3;
+    
+    byte_buffer_t header = {0};
+    for (int i = 0; i < 4; i++) byte_buffer_push(&header, (uint8_t)BINARY_MAGIC[i]);
+    byte_buffer_push_u32(&header, BINARY_VERSION);
+    byte_buffer_push_u32(&header, BINARY_FLAG_CHECKSUM | (compact ? BINARY_FLAG_VARINT : 0));
+    byte_buffer_push_u32(&header, (uint32_t)cnf->num_variables);
+    byte_buffer_push_u64(&header, num_clauses);
+    byte_buffer_push_u64(&header, num_literals);
+    byte_buffer_push_u64(&header, sizes_bytes);
+    byte_buffer_push_u64(&header, payload.size - padded_sizes);
+    byte_buffer_push_u64(&header, binary_checksum(header.data, payload.data, payload.size));
+    
+    bool ok = false;
+    FILE *file = fopen(filename, "wb");
+    if (file) {
+        ok = fwrite(header.data, 1, header.size, file) == header.size &&
+             fwrite(payload.data, 1, payload.size, file) == payload.size;
+        ok = fclose(file) == 0 && ok;
+    }
+    
+    free(header.data);
+    free(payload.data);
+    return ok;
+}
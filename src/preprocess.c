@@ -0,0 +1,1056 @@
+/**
+ * @file preprocess.c
+ * @brief Simplificação da fórmula no nível 0 com listas de ocorrências
+ * @author SAT Solver Team
+ * @date 2025
+ *
+ * Literais equivalentes: componentes fortemente conexas do grafo de
+ * implicações das cláusulas binárias; cada classe é trocada por um
+ * representante em todas as cláusulas.
+ *
+ * Subsunção: uma cláusula C remove as cláusulas que a contêm, e
+ * fortalece (remove ¬l de) as que contêm C com um literal l trocado por
+ * ¬l (resolução auto-subsumida). Assinaturas de 64 bits descartam a
+ * maioria dos pares sem percorrer os literais.
+ *
+ * Cláusulas bloqueadas (BCE): C com um literal l tal que todo resolvente
+ * de C em l é tautológico pode sair; l é a testemunha da reconstrução.
+ *
+ * Eliminação limitada de variáveis do SatELite (BVE): uma
+ * variável x sai da fórmula quando as cláusulas com x e com ¬x podem ser
+ * trocadas por todos os seus resolventes não tautológicos sem aumentar o
+ * número de cláusulas. As cláusulas removidas vão para a pilha de
+ * reconstrução do solver, que extend_model() percorre depois da busca
+ * para dar às variáveis eliminadas valores que satisfazem a fórmula original.
+ */
+
+#include "preprocess.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Resolventes com mais literais que isso impedem a eliminação */
+#define ELIM_RESOLVENT_LIMIT 20
+/* Variáveis com mais ocorrências nas duas polaridades não são tentadas */
+#define ELIM_OCCURRENCE_LIMIT 100
+/* Literais visitados nas resoluções antes de a eliminação parar */
+#define ELIM_STEP_LIMIT 100000000ULL
+/* Literais visitados nas verificações de subsunção antes de ela parar */
+#define SUBSUME_STEP_LIMIT 50000000ULL
+/* Literais com mais ocorrências do oposto não são tentados como bloqueadores */
+#define BLOCK_OCCURRENCE_LIMIT 100
+/* Literais visitados na eliminação de bloqueadas antes de ela parar */
+#define BLOCK_STEP_LIMIT 50000000ULL
+
+/* Identificadores das cláusulas do simplificador que contêm um literal */
+typedef struct {
+    uint32_t *ids;
+    size_t size;
+    size_t capacity;
+} occurrence_list_t;
+
+/* Candidata à eliminação, ordenada pelo custo estimado */
+typedef struct {
+    uint64_t cost;              /* Ocorrências positivas x negativas */
+    variable_t var;
+} elim_candidate_t;
+
+/* Estado de uma simplificação: listas de ocorrências das cláusulas originais */
+typedef struct {
+    dpll_solver_t *solver;
+    cnf_formula_t *formula;
+    clause_ref_t *refs;             /* Cláusula de cada identificador */
+    uint64_t *signatures;           /* Bit (var % 64) de cada variável da cláusula */
+    size_t num_clauses;
+    size_t capacity;
+    occurrence_list_t *occurs;      /* Por literal_index(); removidas saem ao percorrer */
+    bool *touched;                  /* Variáveis que perderam ocorrências desde a última rodada */
+    elim_candidate_t *candidates;   /* Variáveis da rodada atual */
+    clause_normalizer_t normalizer; /* Tautologias e duplicatas dos resolventes */
+    literal_vector_t resolvent;     /* Resolvente em construção */
+    occurrence_list_t subsume_queue;/* Cláusulas ainda não usadas para subsumir outras */
+    occurrence_list_t candidates_scratch; /* Cópia das ocorrências percorridas na subsunção */
+    uint32_t *marks;                /* Carimbo por literal_index() dos literais de uma cláusula */
+    uint32_t stamp;
+    size_t propagated;              /* Entradas da pilha já aplicadas às ocorrências */
+    uint64_t steps;                 /* Literais visitados nas resoluções */
+    uint64_t subsume_steps;         /* Literais visitados na subsunção */
+    uint64_t block_steps;           /* Literais visitados na eliminação de bloqueadas */
+    uint64_t subsume_limit;         /* Orçamento da subsunção; zero a desativa */
+    uint64_t block_limit;           /* Orçamento da eliminação de bloqueadas */
+    uint64_t elim_limit;            /* Orçamento das resoluções da BVE */
+    bool unsat;                     /* Cláusula vazia derivada */
+} simplifier_t;
+
+/* ========== Listas de Ocorrências ========== */
+
+static void occurrence_push(occurrence_list_t *list, uint32_t id) {
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity > 0 ? 2 * list->capacity : 4;
+        list->ids = safe_realloc(list->ids, list->capacity * sizeof(uint32_t));
+    }
+    list->ids[list->size++] = id;
+}
+
+static void occurrence_remove(occurrence_list_t *list, uint32_t id) {
+    for (size_t k = 0; k < list->size; k++) {
+        if (list->ids[k] == id) {
+            list->ids[k] = list->ids[--list->size];
+            return;
+        }
+    }
+}
+
+static inline clause_t* simplifier_clause(const simplifier_t *s, uint32_t id) {
+    return cnf_clause(s->formula, s->refs[id]);
+}
+
+/* Assinatura por variável: serve à subsunção e ao fortalecimento (l trocado por ¬l) */
+static uint64_t clause_signature(const literal_t *literals, size_t size) {
+    uint64_t signature = 0;
+    for (size_t k = 0; k < size; k++) {
+        signature |= 1ULL << (literal_variable(literals[k]) & 63);
+    }
+    return signature;
+}
+
+/* Novo carimbo para marcar os literais de uma cláusula */
+static uint32_t next_stamp(simplifier_t *s) {
+    if (++s->stamp == 0) {
+        memset(s->marks, 0, 2 * ((size_t)s->formula->num_variables + 1) * sizeof(uint32_t));
+        s->stamp = 1;
+    }
+    return s->stamp;
+}
+
+/* Descarta as cláusulas removidas da lista e devolve quantas restam */
+static size_t live_occurrences(simplifier_t *s, literal_t lit) {
+    occurrence_list_t *list = &s->occurs[literal_index(lit)];
+    size_t kept = 0;
+    for (size_t k = 0; k < list->size; k++) {
+        if (!simplifier_clause(s, list->ids[k])->deleted) {
+            list->ids[kept++] = list->ids[k];
+        }
+    }
+    list->size = kept;
+    return kept;
+}
+
+/* ========== Base de Cláusulas do Simplificador ========== */
+
+/* Registra uma cláusula da fórmula (2+ literais, nenhum atribuído) */
+static void add_clause(simplifier_t *s, clause_ref_t ref) {
+    if (s->num_clauses == s->capacity) {
+        s->capacity = s->capacity > 0 ? 2 * s->capacity : 1024;
+        s->refs = safe_realloc(s->refs, s->capacity * sizeof(clause_ref_t));
+        s->signatures = safe_realloc(s->signatures, s->capacity * sizeof(uint64_t));
+    }
+    uint32_t id = (uint32_t)s->num_clauses++;
+    s->refs[id] = ref;
+
+    const clause_t *clause = cnf_clause(s->formula, ref);
+    s->signatures[id] = clause_signature(clause->literals, clause->size);
+    for (size_t k = 0; k < clause->size; k++) {
+        occurrence_push(&s->occurs[literal_index(clause->literals[k])], id);
+    }
+    occurrence_push(&s->subsume_queue, id);
+}
+
+/* Remove a cláusula da fórmula; suas variáveis voltam a ser candidatas */
+static void remove_clause(simplifier_t *s, uint32_t id) {
+    clause_t *clause = simplifier_clause(s, id);
+    if (clause->deleted) return;
+
+    for (size_t k = 0; k < clause->size; k++) {
+        s->touched[literal_variable(clause->literals[k])] = true;
+    }
+    cnf_delete_clause(s->formula, s->refs[id]);
+}
+
+/* Atribui no nível 0 um literal implicado pela fórmula */
+static void assign_unit(simplifier_t *s, literal_t lit) {
+    var_assignment_t value = literal_value(s->formula->assignment, lit);
+    if (value == VAR_FALSE) {
+        s->unsat = true;
+        return;
+    }
+    if (value == VAR_TRUE) return;
+
+    if (!assign_variable(s->solver, literal_variable(lit),
+                         literal_is_positive(lit) ? VAR_TRUE : VAR_FALSE, false)) {
+        log_error("Falha ao empilhar unitária da simplificação");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Retira um literal de uma cláusula, no lugar
+ *
+ * Restando um único literal, a cláusula sai da fórmula e o literal é
+ * atribuído no nível 0.
+ */
+static void strengthen_clause(simplifier_t *s, uint32_t id, literal_t lit) {
+    clause_t *clause = simplifier_clause(s, id);
+    size_t size = clause->size;
+
+    for (size_t k = 0; k < size; k++) {
+        if (clause->literals[k] == lit) {
+            clause->literals[k] = clause->literals[size - 1];
+            break;
+        }
+    }
+    clause_arena_shrink(&s->formula->arena, s->refs[id], size - 1);
+    occurrence_remove(&s->occurs[literal_index(lit)], id);
+    s->touched[literal_variable(lit)] = true;
+
+    if (size - 1 == 1) {
+        literal_t unit = clause->literals[0];
+        remove_clause(s, id);
+        assign_unit(s, unit);
+        return;
+    }
+    s->signatures[id] = clause_signature(clause->literals, size - 1);
+    occurrence_push(&s->subsume_queue, id);
+}
+
+/**
+ * @brief Aplica às ocorrências as atribuições do nível 0 ainda não vistas
+ *
+ * Cláusulas com o literal verdadeiro saem da fórmula; as com o literal
+ * falso o perdem. As duas listas da variável ficam vazias.
+ */
+static void propagate_units(simplifier_t *s) {
+    const assignment_stack_t *trail = s->solver->assignments;
+
+    while (!s->unsat && s->propagated < trail->size) {
+        const assignment_entry_t *entry = &trail->stack[s->propagated++];
+        literal_t lit = entry->value == VAR_TRUE ? entry->variable : -entry->variable;
+
+        occurrence_list_t satisfied = s->occurs[literal_index(lit)];
+        occurrence_list_t falsified = s->occurs[literal_index(-lit)];
+        memset(&s->occurs[literal_index(lit)], 0, sizeof(occurrence_list_t));
+        memset(&s->occurs[literal_index(-lit)], 0, sizeof(occurrence_list_t));
+
+        for (size_t k = 0; k < satisfied.size; k++) {
+            remove_clause(s, satisfied.ids[k]);
+        }
+        for (size_t k = 0; k < falsified.size && !s->unsat; k++) {
+            if (!simplifier_clause(s, falsified.ids[k])->deleted) {
+                strengthen_clause(s, falsified.ids[k], -lit);
+            }
+        }
+        free(satisfied.ids);
+        free(falsified.ids);
+    }
+}
+
+/**
+ * @brief Prepara as listas de ocorrências das cláusulas originais vivas
+ *
+ * Cláusulas satisfeitas no nível 0 ficam de fora (remove_satisfied_clauses
+ * cuida delas); literais falsos no nível 0 são retirados no lugar.
+ */
+static void simplifier_init(simplifier_t *s, dpll_solver_t *solver) {
+    cnf_formula_t *formula = solver->formula;
+
+    memset(s, 0, sizeof(simplifier_t));
+    s->solver = solver;
+    s->formula = formula;
+    s->occurs = safe_calloc(2 * ((size_t)formula->num_variables + 1), sizeof(occurrence_list_t));
+    s->touched = safe_calloc((size_t)formula->num_variables + 1, sizeof(bool));
+    s->candidates = safe_malloc(((size_t)formula->num_variables + 1) * sizeof(elim_candidate_t));
+    s->marks = safe_calloc(2 * ((size_t)formula->num_variables + 1), sizeof(uint32_t));
+    if (!clause_normalizer_init(&s->normalizer, formula->num_variables, false)) {
+        log_error("Falha ao alocar marcas da simplificação");
+        exit(EXIT_FAILURE);
+    }
+    s->propagated = solver->assignments->size;
+
+    size_t count = formula->clauses.count;
+    for (size_t i = 0; i < count && !s->unsat; i++) {
+        clause_ref_t ref = formula->clauses.refs[i];
+        clause_t *clause = cnf_clause(formula, ref);
+        if (clause->learnt || clause->deleted) continue;
+        if (clause_is_satisfied(clause, formula->assignment)) continue;
+
+        size_t kept = 0;
+        for (size_t k = 0; k < clause->size; k++) {
+            if (literal_value(formula->assignment, clause->literals[k]) != VAR_FALSE) {
+                clause->literals[kept++] = clause->literals[k];
+            }
+        }
+        clause_arena_shrink(&formula->arena, ref, kept);
+
+        if (kept == 0) {
+            s->unsat = true;
+        } else if (kept == 1) {
+            literal_t unit = clause->literals[0];
+            cnf_delete_clause(formula, ref);
+            assign_unit(s, unit);
+        } else {
+            add_clause(s, ref);
+        }
+    }
+
+    propagate_units(s);
+}
+
+static void simplifier_dispose(simplifier_t *s) {
+    size_t num_lists = 2 * ((size_t)s->formula->num_variables + 1);
+    for (size_t i = 0; i < num_lists; i++) {
+        free(s->occurs[i].ids);
+    }
+    free(s->occurs);
+    free(s->touched);
+    free(s->candidates);
+    free(s->refs);
+    free(s->signatures);
+    free(s->marks);
+    free(s->subsume_queue.ids);
+    free(s->candidates_scratch.ids);
+    clause_normalizer_dispose(&s->normalizer);
+    literal_vector_dispose(&s->resolvent);
+}
+
+/* ========== Subsunção ========== */
+
+/**
+ * @brief Usa uma cláusula C para subsumir ou fortalecer as demais
+ * @param s Simplificador
+ * @param id Cláusula C
+ *
+ * Toda cláusula D que contém C (ou C com um literal l trocado por ¬l)
+ * contém a variável de cada literal de C; basta então percorrer as
+ * ocorrências, nas duas polaridades, do literal de C com menos ocorrências.
+ * Com C marcada, cada candidata D custa uma passada sobre seus literais:
+ * - todos os literais de C em D: D é subsumida e sai da fórmula;
+ * - todos menos um, cujo oposto ¬l está em D: ¬l sai de D.
+ */
+static void backward_subsume(simplifier_t *s, uint32_t id) {
+    const clause_t *clause = simplifier_clause(s, id);
+    if (clause->deleted) return;
+
+    literal_t best = clause->literals[0];
+    size_t best_count = SIZE_MAX;
+    uint32_t stamp = next_stamp(s);
+    for (size_t k = 0; k < clause->size; k++) {
+        literal_t lit = clause->literals[k];
+        size_t count = s->occurs[literal_index(lit)].size + s->occurs[literal_index(-lit)].size;
+        if (count < best_count) {
+            best = lit;
+            best_count = count;
+        }
+        s->marks[literal_index(lit)] = stamp;
+    }
+
+    /* Fortalecer D altera as listas percorridas: trabalhar sobre uma cópia */
+    occurrence_list_t *candidates = &s->candidates_scratch;
+    candidates->size = 0;
+    literal_t polarities[2] = { best, -best };
+    for (int p = 0; p < 2; p++) {
+        const occurrence_list_t *list = &s->occurs[literal_index(polarities[p])];
+        for (size_t k = 0; k < list->size; k++) {
+            occurrence_push(candidates, list->ids[k]);
+        }
+    }
+    s->subsume_steps += candidates->size;
+
+    uint64_t signature = s->signatures[id];
+    size_t size = clause->size;
+    for (size_t c = 0; c < candidates->size && !s->unsat; c++) {
+        uint32_t other_id = candidates->ids[c];
+        if (other_id == id) continue;
+        const clause_t *other = simplifier_clause(s, other_id);
+        if (other->deleted || other->size < size || (signature & ~s->signatures[other_id])) continue;
+
+        s->subsume_steps += other->size;
+        size_t matched = 0;
+        size_t flipped = 0;
+        literal_t flipped_lit = 0;
+        for (size_t k = 0; k < other->size; k++) {
+            literal_t lit = other->literals[k];
+            if (s->marks[literal_index(lit)] == stamp) {
+                matched++;
+            } else if (s->marks[literal_index(-lit)] == stamp) {
+                flipped++;
+                flipped_lit = lit;
+            }
+        }
+
+        if (matched == size) {
+            remove_clause(s, other_id);
+            s->solver->stats.subsumed_clauses++;
+        } else if (matched + 1 == size && flipped == 1) {
+            strengthen_clause(s, other_id, flipped_lit);
+            s->solver->stats.strengthened_literals++;
+        }
+    }
+}
+
+/**
+ * @brief Esvazia a fila de subsunção dentro do orçamento de passos
+ *
+ * A fila recebe toda cláusula registrada ou fortalecida; unitárias
+ * derivadas pelo fortalecimento são propagadas a cada cláusula processada.
+ */
+static void subsume_queued(simplifier_t *s) {
+    occurrence_list_t *queue = &s->subsume_queue;
+    size_t head = 0;
+
+    while (head < queue->size && !s->unsat && s->subsume_steps <= s->subsume_limit) {
+        backward_subsume(s, queue->ids[head++]);
+        propagate_units(s);
+    }
+    queue->size = 0;
+}
+
+/**
+ * @brief Indica se alguma cláusula da fórmula está contida nos literais dados
+ *
+ * Subsunção para frente, usada nos resolventes antes de entrarem na
+ * fórmula. Como a cláusula subsumidora pode conter qualquer dos literais,
+ * percorre as ocorrências de todos eles; desiste ao passar do orçamento.
+ */
+static bool forward_subsumed(simplifier_t *s, const literal_t *literals, size_t size) {
+    if (s->subsume_steps > s->subsume_limit) return false;
+
+    uint64_t signature = clause_signature(literals, size);
+    uint32_t stamp = next_stamp(s);
+    for (size_t k = 0; k < size; k++) {
+        s->marks[literal_index(literals[k])] = stamp;
+    }
+
+    for (size_t k = 0; k < size; k++) {
+        const occurrence_list_t *list = &s->occurs[literal_index(literals[k])];
+        for (size_t i = 0; i < list->size; i++) {
+            const clause_t *clause = simplifier_clause(s, list->ids[i]);
+            if (clause->deleted || clause->size > size ||
+                (s->signatures[list->ids[i]] & ~signature)) {
+                continue;
+            }
+            s->subsume_steps += clause->size;
+            size_t matched = 0;
+            while (matched < clause->size &&
+                   s->marks[literal_index(clause->literals[matched])] == stamp) {
+                matched++;
+            }
+            if (matched == clause->size) return true;
+        }
+    }
+    return false;
+}
+
+/* ========== Eliminação de Variáveis ========== */
+
+/**
+ * @brief Calcula o resolvente de duas cláusulas em s->resolvent
+ * @return false se o resolvente é tautológico ou já satisfeito no nível 0
+ *
+ * Literais falsos no nível 0 (de unitárias ainda não propagadas) ficam de fora.
+ */
+static bool resolve(simplifier_t *s, uint32_t positive, uint32_t negative, variable_t var) {
+    const clause_t *sides[2] = { simplifier_clause(s, positive), simplifier_clause(s, negative) };
+    literal_vector_t *resolvent = &s->resolvent;
+    resolvent->size = 0;
+
+    for (int side = 0; side < 2; side++) {
+        const clause_t *clause = sides[side];
+        s->steps += clause->size;
+        for (size_t k = 0; k < clause->size; k++) {
+            literal_t lit = clause->literals[k];
+            if (literal_variable(lit) == var) continue;
+
+            var_assignment_t value = literal_value(s->formula->assignment, lit);
+            if (value == VAR_TRUE) return false;
+            if (value == VAR_FALSE) continue;
+            if (!literal_vector_push(resolvent, lit)) {
+                log_error("Falha ao expandir resolvente");
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    return clause_normalize(&s->normalizer, resolvent->literals, &resolvent->size);
+}
+
+/* Empilha uma cláusula removida com a testemunha na primeira posição */
+static void push_reconstruction(dpll_solver_t *solver, literal_t witness,
+                                const literal_t *literals, size_t size) {
+    literal_vector_t *stack = &solver->reconstruction;
+    bool pushed = literal_vector_push(stack, witness);
+    for (size_t k = 0; k < size && pushed; k++) {
+        if (literals[k] != witness) {
+            pushed = literal_vector_push(stack, literals[k]);
+        }
+    }
+    if (!pushed || !literal_vector_push(stack, (literal_t)size)) {
+        log_error("Falha ao expandir pilha de reconstrução");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Tenta eliminar uma variável por resolução
+ * @return true se a variável saiu da fórmula
+ *
+ * A eliminação só acontece se os resolventes não tautológicos não forem
+ * mais numerosos que as cláusulas removidas e nenhum passar de
+ * ELIM_RESOLVENT_LIMIT literais. Variáveis puras (um lado vazio) saem
+ * sem gerar resolventes.
+ *
+ * Para a reconstrução, guarda as cláusulas do lado menor com o literal de
+ * x como testemunha, precedidas pela unitária oposta: extend_model() dá a
+ * x o valor da unitária e só o inverte se alguma delas ficar falsa.
+ */
+static bool try_eliminate(simplifier_t *s, variable_t var) {
+    size_t num_positive = live_occurrences(s, var);
+    size_t num_negative = live_occurrences(s, -var);
+    if (num_positive == 0 && num_negative == 0) return false;
+    if (num_positive > 0 && num_negative > 0 &&
+        num_positive + num_negative > ELIM_OCCURRENCE_LIMIT) {
+        return false;
+    }
+
+    const occurrence_list_t *positive = &s->occurs[literal_index(var)];
+    const occurrence_list_t *negative = &s->occurs[literal_index(-var)];
+
+    /* Contagem: o número de cláusulas não pode crescer */
+    size_t limit = num_positive + num_negative;
+    size_t resolvents = 0;
+    for (size_t i = 0; i < num_positive; i++) {
+        for (size_t j = 0; j < num_negative; j++) {
+            if (!resolve(s, positive->ids[i], negative->ids[j], var)) continue;
+            if (++resolvents > limit || s->resolvent.size > ELIM_RESOLVENT_LIMIT) return false;
+        }
+        if (s->steps > s->elim_limit) return false;
+    }
+
+    /* Reconstrução: lado menor com a testemunha, depois a unitária oposta */
+    bool keep_positive = num_positive <= num_negative;
+    const occurrence_list_t *kept = keep_positive ? positive : negative;
+    literal_t witness = keep_positive ? var : -var;
+    for (size_t i = 0; i < kept->size; i++) {
+        const clause_t *clause = simplifier_clause(s, kept->ids[i]);
+        push_reconstruction(s->solver, witness, clause->literals, clause->size);
+    }
+    literal_t default_value = -witness;
+    push_reconstruction(s->solver, default_value, &default_value, 1);
+
+    /* Resolventes entram na fórmula; a arena pode mudar de endereço */
+    for (size_t i = 0; i < num_positive && !s->unsat; i++) {
+        for (size_t j = 0; j < num_negative && !s->unsat; j++) {
+            if (!resolve(s, positive->ids[i], negative->ids[j], var)) continue;
+            if (s->subsume_limit > 0 &&
+                forward_subsumed(s, s->resolvent.literals, s->resolvent.size)) {
+                continue;
+            }
+            s->solver->stats.resolvents++;
+
+            if (s->resolvent.size == 0) {
+                s->unsat = true;
+            } else if (s->resolvent.size == 1) {
+                assign_unit(s, s->resolvent.literals[0]);
+            } else {
+                clause_ref_t ref = cnf_add_clause_literals(s->formula, s->resolvent.literals,
+                                                           s->resolvent.size, false);
+                if (ref == CLAUSE_REF_UNDEF) {
+                    log_error("Falha ao adicionar resolvente");
+                    exit(EXIT_FAILURE);
+                }
+                add_clause(s, ref);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < num_positive; i++) {
+        remove_clause(s, positive->ids[i]);
+    }
+    for (size_t j = 0; j < num_negative; j++) {
+        remove_clause(s, negative->ids[j]);
+    }
+
+    s->solver->eliminated[var] = true;
+    s->solver->eliminated_count++;
+    s->solver->stats.eliminated_vars++;
+    return true;
+}
+
+static int compare_candidates(const void *a, const void *b) {
+    uint64_t x = ((const elim_candidate_t*)a)->cost;
+    uint64_t y = ((const elim_candidate_t*)b)->cost;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Eliminação de variáveis limitada (SatELite)
+ *
+ * Trabalha em rodadas: a primeira tenta todas as variáveis livres, das de
+ * menor custo (ocorrências positivas x negativas) para as maiores; as
+ * seguintes, só as que perderam ocorrências na rodada anterior. Resolventes
+ * unitários são atribuídos e propagados nas listas de ocorrências; com a
+ * subsunção ativa, os resolventes novos subsumem e fortalecem as demais
+ * cláusulas ao fim de cada rodada.
+ */
+static void eliminate_variables(simplifier_t *s) {
+    dpll_solver_t *solver = s->solver;
+    variable_t num_variables = s->formula->num_variables;
+
+    for (variable_t var = 1; var <= num_variables; var++) {
+        s->touched[var] = true;
+    }
+
+    while (!s->unsat && s->steps <= s->elim_limit) {
+        size_t num_candidates = 0;
+        for (variable_t var = 1; var <= num_variables; var++) {
+            if (!s->touched[var]) continue;
+            s->touched[var] = false;
+            if (IS_VARIABLE_ASSIGNED(solver, var) || IS_VARIABLE_ELIMINATED(solver, var)) continue;
+
+            s->candidates[num_candidates].cost = (uint64_t)s->occurs[literal_index(var)].size *
+                                                 s->occurs[literal_index(-var)].size;
+            s->candidates[num_candidates].var = var;
+            num_candidates++;
+        }
+        if (num_candidates == 0) break;
+        qsort(s->candidates, num_candidates, sizeof(elim_candidate_t), compare_candidates);
+
+        for (size_t i = 0; i < num_candidates && !s->unsat && s->steps <= s->elim_limit; i++) {
+            variable_t var = s->candidates[i].var;
+            if (IS_VARIABLE_ASSIGNED(solver, var)) continue;
+            if (try_eliminate(s, var)) {
+                propagate_units(s);
+            }
+        }
+
+        if (s->subsume_limit > 0) {
+            subsume_queued(s);
+        }
+    }
+}
+
+/* ========== Cláusulas Bloqueadas ========== */
+
+/**
+ * @brief Indica se a cláusula está bloqueada no literal dado
+ *
+ * C é bloqueada em l quando todo resolvente de C com uma cláusula que
+ * contém ¬l é tautológico, isto é, quando cada uma dessas cláusulas
+ * contém o oposto de outro literal de C.
+ */
+static bool clause_is_blocked(simplifier_t *s, uint32_t id, literal_t lit) {
+    const clause_t *clause = simplifier_clause(s, id);
+    uint32_t stamp = next_stamp(s);
+    for (size_t k = 0; k < clause->size; k++) {
+        s->marks[literal_index(clause->literals[k])] = stamp;
+    }
+
+    const occurrence_list_t *list = &s->occurs[literal_index(-lit)];
+    for (size_t i = 0; i < list->size; i++) {
+        const clause_t *other = simplifier_clause(s, list->ids[i]);
+        if (other->deleted) continue;
+
+        s->block_steps += other->size;
+        bool tautology = false;
+        for (size_t k = 0; k < other->size && !tautology; k++) {
+            literal_t other_lit = other->literals[k];
+            tautology = other_lit != -lit && s->marks[literal_index(-other_lit)] == stamp;
+        }
+        if (!tautology) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Elimina cláusulas bloqueadas (BCE)
+ *
+ * Percorre uma fila de literais l, testando cada cláusula com l contra as
+ * que têm ¬l. Uma cláusula bloqueada sai da fórmula e vai para a pilha de
+ * reconstrução com l como testemunha. Removê-la encolhe as listas dos seus
+ * literais m, o que pode bloquear cláusulas em ¬m: esses literais voltam
+ * para a fila.
+ */
+static void eliminate_blocked(simplifier_t *s) {
+    variable_t num_variables = s->formula->num_variables;
+    bool *queued = safe_calloc(2 * ((size_t)num_variables + 1), sizeof(bool));
+    occurrence_list_t queue = {0};
+
+    for (variable_t var = 1; var <= num_variables; var++) {
+        if (IS_VARIABLE_ASSIGNED(s->solver, var) || IS_VARIABLE_ELIMINATED(s->solver, var)) continue;
+        occurrence_push(&queue, (uint32_t)literal_index(var));
+        occurrence_push(&queue, (uint32_t)literal_index(-var));
+        queued[literal_index(var)] = true;
+        queued[literal_index(-var)] = true;
+    }
+
+    for (size_t head = 0; head < queue.size && s->block_steps <= s->block_limit; head++) {
+        size_t index = queue.ids[head];
+        queued[index] = false;
+        literal_t lit = (index & 1) ? -(literal_t)(index >> 1) : (literal_t)(index >> 1);
+        if (live_occurrences(s, -lit) > BLOCK_OCCURRENCE_LIMIT) continue;
+
+        /* Remover só marca a cláusula: a lista de lit não muda durante a passada */
+        const occurrence_list_t *list = &s->occurs[literal_index(lit)];
+        for (size_t i = 0; i < list->size && s->block_steps <= s->block_limit; i++) {
+            uint32_t id = list->ids[i];
+            const clause_t *clause = simplifier_clause(s, id);
+            if (clause->deleted || !clause_is_blocked(s, id, lit)) continue;
+
+            push_reconstruction(s->solver, lit, clause->literals, clause->size);
+            for (size_t k = 0; k < clause->size; k++) {
+                literal_t opposite = -clause->literals[k];
+                if (opposite != -lit && !queued[literal_index(opposite)]) {
+                    queued[literal_index(opposite)] = true;
+                    occurrence_push(&queue, (uint32_t)literal_index(opposite));
+                }
+            }
+            remove_clause(s, id);
+            s->solver->stats.blocked_clauses++;
+        }
+    }
+
+    free(queued);
+    free(queue.ids);
+}
+
+/* ========== Literais Equivalentes ========== */
+
+/* Quadro da busca em profundidade iterativa de Tarjan */
+typedef struct {
+    size_t node;                /* literal_index() do literal visitado */
+    size_t edge;                /* Próxima aresta a seguir */
+} tarjan_frame_t;
+
+/**
+ * @brief Encontra literais equivalentes no grafo de implicações binárias (Tarjan)
+ * @param solver Instância do solver, no nível 0
+ * @param representative Saída por literal_index(): representante do literal, 0 se é ele mesmo
+ * @param found Saída: número de literais com representante
+ * @return false se algum literal é equivalente à própria negação
+ *
+ * Cada binária (a ∨ b) não satisfeita dá as arestas ¬a → b e ¬b → a;
+ * os literais de uma componente fortemente conexa são equivalentes. O
+ * representante é o literal de menor variável da componente; como a
+ * componente dual tem as negações, ela escolhe a negação do mesmo
+ * representante. A busca é iterativa, sem recursão, para aguentar
+ * cadeias de milhões de literais.
+ */
+static bool find_equivalences(dpll_solver_t *solver, literal_t *representative, size_t *found) {
+    const cnf_formula_t *formula = solver->formula;
+    size_t num_literals = 2 * ((size_t)formula->num_variables + 1);
+    *found = 0;
+
+    /* Grafo em CSR: start[l]..start[l + 1] são as implicações de l */
+    size_t *start = safe_calloc(num_literals + 1, sizeof(size_t));
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        const clause_t *clause = cnf_clause(formula, formula->clauses.refs[i]);
+        if (clause->deleted || clause->size != 2) continue;
+        if (literal_value(formula->assignment, clause->literals[0]) != VAR_UNASSIGNED ||
+            literal_value(formula->assignment, clause->literals[1]) != VAR_UNASSIGNED) {
+            continue;
+        }
+        start[literal_index(-clause->literals[0]) + 1]++;
+        start[literal_index(-clause->literals[1]) + 1]++;
+    }
+    for (size_t l = 0; l < num_literals; l++) {
+        start[l + 1] += start[l];
+    }
+    if (start[num_literals] == 0) {
+        free(start);
+        return true;
+    }
+
+    size_t *edges = safe_malloc(start[num_literals] * sizeof(size_t));
+    size_t *fill = safe_malloc(num_literals * sizeof(size_t));
+    memcpy(fill, start, num_literals * sizeof(size_t));
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        const clause_t *clause = cnf_clause(formula, formula->clauses.refs[i]);
+        if (clause->deleted || clause->size != 2) continue;
+        literal_t a = clause->literals[0];
+        literal_t b = clause->literals[1];
+        if (literal_value(formula->assignment, a) != VAR_UNASSIGNED ||
+            literal_value(formula->assignment, b) != VAR_UNASSIGNED) {
+            continue;
+        }
+        edges[fill[literal_index(-a)]++] = literal_index(b);
+        edges[fill[literal_index(-b)]++] = literal_index(a);
+    }
+
+    /* index 0 = não visitado; component marca a componente já fechada */
+    uint32_t *index = safe_calloc(num_literals, sizeof(uint32_t));
+    uint32_t *low = safe_malloc(num_literals * sizeof(uint32_t));
+    size_t *component = fill;
+    memset(component, 0, num_literals * sizeof(size_t));
+    size_t *scc = safe_malloc(num_literals * sizeof(size_t));
+    tarjan_frame_t *frames = safe_malloc(num_literals * sizeof(tarjan_frame_t));
+    size_t scc_size = 0;
+    uint32_t counter = 0;
+    bool consistent = true;
+
+    for (size_t root = 2; root < num_literals && consistent; root++) {
+        if (index[root] != 0 || start[root] == start[root + 1]) continue;
+
+        size_t depth = 0;
+        frames[depth++] = (tarjan_frame_t){ root, start[root] };
+        index[root] = low[root] = ++counter;
+        scc[scc_size++] = root;
+
+        while (depth > 0 && consistent) {
+            tarjan_frame_t *frame = &frames[depth - 1];
+            size_t v = frame->node;
+
+            if (frame->edge < start[v + 1]) {
+                size_t w = edges[frame->edge++];
+                if (index[w] == 0) {
+                    index[w] = low[w] = ++counter;
+                    scc[scc_size++] = w;
+                    frames[depth++] = (tarjan_frame_t){ w, start[w] };
+                } else if (component[w] == 0 && index[w] < low[v]) {
+                    low[v] = index[w];
+                }
+                continue;
+            }
+
+            depth--;
+            if (depth > 0 && low[v] < low[frames[depth - 1].node]) {
+                low[frames[depth - 1].node] = low[v];
+            }
+            if (low[v] != index[v]) continue;
+
+            /* v é a raiz de uma componente: ela está no topo da pilha */
+            size_t first = scc_size;
+            do {
+                first--;
+                component[scc[first]] = v + 1;
+            } while (scc[first] != v);
+
+            literal_t best = 0;
+            for (size_t k = first; k < scc_size && consistent; k++) {
+                size_t l = scc[k];
+                if (component[l ^ 1] == v + 1) {
+                    consistent = false;
+                }
+                literal_t lit = (l & 1) ? -(literal_t)(l >> 1) : (literal_t)(l >> 1);
+                if (best == 0 || literal_variable(lit) < literal_variable(best)) {
+                    best = lit;
+                }
+            }
+            for (size_t k = first; k < scc_size && consistent && scc_size - first > 1; k++) {
+                size_t l = scc[k];
+                if (l != literal_index(best)) {
+                    representative[l] = best;
+                    (*found)++;
+                }
+            }
+            scc_size = first;
+        }
+    }
+
+    free(start);
+    free(edges);
+    free(fill);
+    free(index);
+    free(low);
+    free(scc);
+    free(frames);
+    return consistent;
+}
+
+/**
+ * @brief Substitui cada literal equivalente pelo representante de sua classe
+ * @param solver Instância do solver, no nível 0
+ * @return false se a fórmula é insatisfatível
+ *
+ * Todas as cláusulas, originais e aprendidas, são reescritas no lugar:
+ * as que viram tautologia saem (entre elas as binárias da própria
+ * equivalência), literais repetidos são retirados e as que ficam com um
+ * literal só viram atribuições do nível 0. Cada variável x substituída por
+ * r sai da busca como eliminada; a pilha de reconstrução recebe
+ * (x ∨ ¬r) e (¬x ∨ r), que extend_model() usa para copiar o valor de r.
+ */
+static bool substitute_equivalences(dpll_solver_t *solver) {
+    cnf_formula_t *formula = solver->formula;
+    variable_t num_variables = formula->num_variables;
+    literal_t *representative = safe_calloc(2 * ((size_t)num_variables + 1), sizeof(literal_t));
+
+    size_t found = 0;
+    bool consistent = find_equivalences(solver, representative, &found);
+    if (!consistent || found == 0) {
+        free(representative);
+        return consistent;
+    }
+
+    clause_normalizer_t normalizer;
+    if (!clause_normalizer_init(&normalizer, num_variables, false)) {
+        log_error("Falha ao alocar marcas da substituição de equivalentes");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < formula->clauses.count && consistent; i++) {
+        clause_ref_t ref = formula->clauses.refs[i];
+        clause_t *clause = cnf_clause(formula, ref);
+        if (clause->deleted) continue;
+
+        bool changed = false;
+        for (size_t k = 0; k < clause->size; k++) {
+            literal_t replacement = representative[literal_index(clause->literals[k])];
+            if (replacement != 0) {
+                clause->literals[k] = replacement;
+                changed = true;
+            }
+        }
+        if (!changed) continue;
+
+        size_t size = clause->size;
+        if (!clause_normalize(&normalizer, clause->literals, &size)) {
+            cnf_delete_clause(formula, ref);
+            continue;
+        }
+        clause_arena_shrink(&formula->arena, ref, size);
+        if (size == 1) {
+            literal_t unit = clause->literals[0];
+            cnf_delete_clause(formula, ref);
+            var_assignment_t value = literal_value(formula->assignment, unit);
+            if (value == VAR_FALSE) {
+                consistent = false;
+            } else if (value == VAR_UNASSIGNED &&
+                       !assign_variable(solver, literal_variable(unit),
+                                        literal_is_positive(unit) ? VAR_TRUE : VAR_FALSE, false)) {
+                log_error("Falha ao empilhar unitária da substituição");
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    for (variable_t var = 1; var <= num_variables; var++) {
+        literal_t r = representative[literal_index(var)];
+        if (r == 0) continue;
+
+        literal_t implies[2] = { var, -r };
+        literal_t implied[2] = { -var, r };
+        push_reconstruction(solver, var, implies, 2);
+        push_reconstruction(solver, -var, implied, 2);
+        solver->eliminated[var] = true;
+        solver->eliminated_count++;
+        solver->stats.substituted_vars++;
+    }
+
+    clause_normalizer_dispose(&normalizer);
+    free(representative);
+    return consistent;
+}
+
+/* ========== Simplificação no Nível 0 ========== */
+
+/**
+ * @brief Equivalências, subsunção, bloqueadas e eliminação de variáveis no nível 0, conforme a configuração
+ * @param solver Instância do solver, com a propagação completa
+ * @param subsume_budget Literais visitados pela subsunção; zero a pula
+ * @param elim_budget Literais visitados por bloqueadas e BVE, cada uma; zero pula
+ *        também as equivalências
+ * @return false se a fórmula é insatisfatível
+ *
+ * A substituição de equivalentes vem primeiro, direto na arena. Depois as
+ * listas de ocorrências são montadas uma vez e compartilhadas: a
+ * subsunção roda sobre todas as cláusulas, seguida da remoção de
+ * bloqueadas, e a eliminação encontra a fórmula já reduzida. Cláusulas aprendidas não participam:
+ * as que citam variáveis eliminadas são descartadas por quem reconstrói
+ * o solver. Os orçamentos nunca passam dos limites fixos de cada técnica.
+ */
+bool simplify_occurrences(dpll_solver_t *solver, uint64_t subsume_budget, uint64_t elim_budget) {
+    if (!solver || solver->assignments->decision_level > 0) return true;
+    if (solver->formula->num_variables == 0) return true;
+
+    const solver_config_t *config = &solver->config;
+    bool subsume = config->enable_subsumption && subsume_budget > 0;
+    bool block = config->enable_blocked && elim_budget > 0;
+    bool eliminate = config->enable_elimination && elim_budget > 0;
+
+    solver_stats_t before = solver->stats;
+    if (config->enable_equivalences && elim_budget > 0 && !substitute_equivalences(solver)) {
+        return false;
+    }
+    if (!subsume && !block && !eliminate) {
+        return true;
+    }
+
+    simplifier_t s;
+    simplifier_init(&s, solver);
+    s.subsume_limit = subsume ? MIN(subsume_budget, SUBSUME_STEP_LIMIT) : 0;
+    s.block_limit = MIN(elim_budget, BLOCK_STEP_LIMIT);
+    s.elim_limit = MIN(elim_budget, ELIM_STEP_LIMIT);
+
+    if (subsume) {
+        subsume_queued(&s);
+    }
+    s.subsume_queue.size = 0;
+    if (block && !s.unsat) {
+        eliminate_blocked(&s);
+    }
+    if (eliminate && !s.unsat) {
+        eliminate_variables(&s);
+    }
+
+    /* Variáveis que ficaram sem cláusulas não precisam ser decididas */
+    for (variable_t var = 1; var <= solver->formula->num_variables && !s.unsat; var++) {
+        if (IS_VARIABLE_ASSIGNED(solver, var) || IS_VARIABLE_ELIMINATED(solver, var)) continue;
+        if (live_occurrences(&s, var) == 0 && live_occurrences(&s, -var) == 0) {
+            solver->eliminated[var] = true;
+            solver->eliminated_count++;
+        }
+    }
+
+    bool consistent = !s.unsat;
+    simplifier_dispose(&s);
+
+    if (solver->config.verbose) {
+        log_debug("Simplificação: %llu substituídas, %llu subsumidas, %llu literais removidos, "
+                  "%llu bloqueadas, %llu variáveis eliminadas, %zu cláusulas",
+                  (unsigned long long)(solver->stats.substituted_vars - before.substituted_vars),
+                  (unsigned long long)(solver->stats.subsumed_clauses - before.subsumed_clauses),
+                  (unsigned long long)(solver->stats.strengthened_literals -
+                                       before.strengthened_literals),
+                  (unsigned long long)(solver->stats.blocked_clauses - before.blocked_clauses),
+                  (unsigned long long)(solver->stats.eliminated_vars - before.eliminated_vars),
+                  solver->formula->clauses.count);
+    }
+    return consistent;
+}
+
+/* ========== Reconstrução do Modelo ========== */
+
+/**
+ * @brief Completa o modelo com as variáveis eliminadas
+ * @param solver Solver que acabou de responder SAT
+ *
+ * Variáveis ainda livres recebem FALSE (o mesmo valor que a saída lhes
+ * daria), para que todo literal tenha valor definido. A pilha de
+ * reconstrução é percorrida do topo para a base: cada cláusula falsa no
+ * modelo atual é satisfeita invertendo sua testemunha. Escreve direto em
+ * formula->assignment, sem passar pela pilha de atribuições.
+ */
+void extend_model(dpll_solver_t *solver) {
+    if (!solver) return;
+
+    var_assignment_t *assignment = solver->formula->assignment;
+    for (variable_t var = 1; var <= solver->formula->num_variables; var++) {
+        if (assignment[var] == VAR_UNASSIGNED) {
+            assignment[var] = VAR_FALSE;
+        }
+    }
+
+    const literal_vector_t *stack = &solver->reconstruction;
+    size_t end = stack->size;
+    while (end > 0) {
+        size_t size = (size_t)stack->literals[end - 1];
+        const literal_t *clause = &stack->literals[end - 1 - size];
+        end -= size + 1;
+
+        bool satisfied = false;
+        for (size_t k = 0; k < size && !satisfied; k++) {
+            satisfied = literal_value(assignment, clause[k]) == VAR_TRUE;
+        }
+        if (!satisfied) {
+            assignment[literal_variable(clause[0])] = literal_is_positive(clause[0]) ? VAR_TRUE
+                                                                                      : VAR_FALSE;
+        }
+    }
+}
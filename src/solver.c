@@ -6,16 +6,41 @@
  * 
  * Este arquivo implementa o núcleo do SAT solver usando o algoritmo DPLL
  * (Davis-Putnam-Logemann-Loveland) com otimizações modernas incluindo:
- * - Propagação unitária eficiente
+ * - Propagação unitária com dois literais observados (two-watched literals)
  * - Eliminação de literais puros
  * - Backtracking robusto com inversão de decisões
+ * - Modo CDCL: análise de conflitos pelo primeiro UIP e backjumping
  * - Múltiplas heurísticas de escolha de variáveis
  * - Detecção de tautologias e simplificações
  */
 
 #include "solver.h"
-#include <math.h>
+#include "preprocess.h"
 #include <float.h>
+#include <string.h>
+
+/* Funções internas da propagação com literais observados */
+static bool attach_clause(dpll_solver_t *solver, clause_ref_t cref);
+static bool enqueue_unit_clauses(dpll_solver_t *solver);
+static clause_ref_t propagate(dpll_solver_t *solver);
+static bool push_assignment(dpll_solver_t *solver, variable_t var, var_assignment_t value,
+                            bool is_decision, clause_ref_t reason);
+static void update_clause_scores(dpll_solver_t *solver, clause_ref_t cref, bool satisfied);
+static uint32_t compute_lbd(dpll_solver_t *solver, const literal_t *literals, size_t size);
+static void bump_learnt_clause(dpll_solver_t *solver, clause_t *clause);
+static bool clause_is_locked(const dpll_solver_t *solver, clause_ref_t cref);
+static void check_garbage(dpll_solver_t *solver);
+static bool rebuild_search_structures(dpll_solver_t *solver);
+static bool inprocessing_due(const dpll_solver_t *solver);
+static inprocess_schedule_t schedule_start(uint64_t interval);
+
+/* Tabela de pesos Jeroslow-Wang: JW_WEIGHTS[k] = 2^-k (cláusulas maiores pesam 0) */
+#define JW_TABLE_SIZE 64
+static double JW_WEIGHTS[JW_TABLE_SIZE];
+
+static inline double jw_weight(size_t clause_size) {
+    return clause_size < JW_TABLE_SIZE ? JW_WEIGHTS[clause_size] : 0.0;
+}
 
 /**
  * @brief Configuração padrão do solver com heurísticas otimizadas
@@ -28,13 +53,39 @@
  */
 const solver_config_t DEFAULT_SOLVER_CONFIG = {
     .decision_strategy = DECISION_JEROSLOW_WANG,  ///< Heurística balanceada
+    .search_mode = SEARCH_DPLL,                    ///< DPLL clássico (CDCL opcional)
     .enable_pure_literal = true,                   ///< Eliminação de literais puros
     .enable_unit_propagation = true,               ///< Propagação unitária
     .enable_preprocessing = true,                  ///< Simplificação inicial
+    .enable_elimination = true,                    ///< Eliminação de variáveis (BVE)
+    .enable_subsumption = true,                    ///< Subsunção e auto-subsunção
+    .enable_probing = true,                        ///< Sondagem de literais falhos
+    .enable_equivalences = true,                   ///< Substituição de literais equivalentes
+    .enable_blocked = true,                        ///< Eliminação de cláusulas bloqueadas
+    .enable_vivification = true,                   ///< Vivificação de cláusulas
+    .enable_inprocessing = true,                   ///< Simplificações periódicas no CDCL
     .enable_restarts = false,                     ///< Restarts desabilitados por padrão
     .max_decisions = 0,                           ///< Sem limite de decisões
     .timeout_seconds = 0.0,                       ///< Sem timeout
     .restart_threshold = 1000,                    ///< Threshold para restarts
+    .restart_policy = RESTART_FIXED,              ///< Intervalo fixo (restart_threshold)
+    .restart_factor = 1.5,                        ///< Razão da política geométrica
+    .luby_unit = 100,                             ///< Luby: 100, 100, 200, 100, ...
+    .glucose_margin = 1.25,                       ///< Reinicia com LBD recente 25% acima
+    .glucose_block_margin = 1.4,                  ///< Bloqueia com pilha 40% acima da média
+    .vsids_decay = 0.95,                          ///< Decaimento VSIDS
+    .garbage_fraction = 0.20,                     ///< Coleta com 20% da arena desperdiçada
+    .reduce_interval = 2000,                      ///< Primeira redução após 2000 conflitos
+    .reduce_increment = 300,                      ///< Intervalos crescentes entre reduções
+    .core_lbd = 2,                                ///< Camada core: LBD <= 2
+    .tier2_lbd = 6,                               ///< Camada intermediária: LBD <= 6
+    .clause_decay = 0.999,                        ///< Decaimento da atividade das aprendidas
+    .inprocess_interval = 2000,                   ///< Primeiras execuções após 2000 conflitos
+    .inprocess_growth = 1.5,                      ///< Intervalos crescem 50% a cada execução
+    .probe_effort = 0.05,                         ///< 5% dos ticks da busca
+    .subsume_effort = 0.05,                       ///< 5% dos ticks da busca
+    .elim_effort = 0.1,                           ///< 10% dos ticks da busca
+    .vivify_effort = 0.1,                         ///< 10% dos ticks da busca
     .verbose = false                              ///< Modo silencioso
 };
 
@@ -86,20 +137,129 @@ dpll_solver_t* solver_create_with_config(cnf_formula_t *formula, const solver_co
     
     /* Alocar arrays auxiliares para otimizações */
     solver->pure_literals = safe_calloc(formula->num_variables + 1, sizeof(bool));
-    solver->unit_clauses = safe_malloc(formula->clauses.count * sizeof(clause_t*));
+    solver->unit_clauses = safe_malloc((formula->clauses.count + 1) * sizeof(clause_ref_t));
     solver->unit_clauses_count = 0;
     
     solver->formula_modified = false;
     solver->conflicts_since_restart = 0;
+    solver->restart_limit = solver->config.restart_policy == RESTART_LUBY
+                                ? solver->config.luby_unit
+                                : solver->config.restart_threshold;
+    solver->lbd_ema_fast = 0.0;
+    solver->lbd_ema_slow = 0.0;
+    solver->trail_ema = 0.0;
+    solver->simplified_trail_size = 0;
+    
+    /* Variáveis eliminadas pelo pré-processamento */
+    solver->eliminated = safe_calloc(formula->num_variables + 1, sizeof(bool));
+    solver->eliminated_count = 0;
+    solver->reconstruction = (literal_vector_t){0};
+    
+    /* Estruturas da análise de conflitos */
+    solver->trail_position = safe_calloc(formula->num_variables + 1, sizeof(size_t));
+    solver->seen = safe_calloc(formula->num_variables + 1, sizeof(bool));
+    solver->learnt_buffer = safe_malloc((formula->num_variables + 1) * sizeof(literal_t));
+    solver->level_stamp = safe_calloc(formula->num_variables + 1, sizeof(uint32_t));
+    solver->stamp_counter = 0;
+    
+    /* Base de aprendidas: reduções a cada intervalo, que cresce aos poucos */
+    solver->clause_activity_increment = 1.0;
+    solver->reduce_interval = solver->config.reduce_interval;
+    solver->next_reduce = solver->config.reduce_interval;
+    
+    /* Inprocessamento: as técnicas que remontam listas de ocorrências começam mais tarde */
+    uint64_t interval = solver->config.inprocess_interval;
+    solver->probe_schedule = schedule_start(interval);
+    solver->vivify_schedule = schedule_start(interval);
+    solver->subsume_schedule = schedule_start(2 * interval);
+    solver->elim_schedule = schedule_start(4 * interval);
+    solver->vivify_position = 0;
+    
+    /* VSIDS: todas as variáveis começam com atividade zero no heap */
+    solver->activity = safe_calloc(formula->num_variables + 1, sizeof(double));
+    solver->activity_increment = 1.0;
+    solver->order_heap = NULL;
+    if (solver->config.decision_strategy == DECISION_VSIDS) {
+        solver->order_heap = var_heap_create(formula->num_variables, solver->activity);
+        if (!solver->order_heap) {
+            solver_destroy(solver);
+            return NULL;
+        }
+        for (variable_t var = 1; var <= formula->num_variables; var++) {
+            var_heap_insert(solver->order_heap, var);
+        }
+    }
+    
+    /* Listas de observação: cada cláusula com 2+ literais observa seus dois primeiros */
+    solver->watches = safe_calloc(2 * ((size_t)formula->num_variables + 1), sizeof(watch_list_t));
+    solver->propagation_head = 0;
+    solver->conflict_clause = CLAUSE_REF_UNDEF;
+    
+    /* Contadores de satisfação. O DPLL termina com atribuição parcial quando todas
+       as cláusulas estão satisfeitas, e Jeroslow-Wang/frequência pontuam apenas
+       cláusulas não satisfeitas: ambos exigem saber quais cláusulas cada literal
+       satisfaz. O CDCL com outras heurísticas só conta variáveis atribuídas. */
+    solver->assigned_count = 0;
+    solver->track_satisfaction = false;
+    solver->jw_scores = NULL;
+    solver->literal_frequency = NULL;
+    solver->original_clauses = formula->clauses.count;
+    formula->satisfied_clauses = 0;
+    if (!cnf_build_occurrence_lists(formula)) {
+        solver_destroy(solver);
+        return NULL;
+    }
+    if (JW_WEIGHTS[0] == 0.0) {
+        double weight = 1.0;
+        for (size_t k = 0; k < JW_TABLE_SIZE; k++, weight *= 0.5) {
+            JW_WEIGHTS[k] = weight;
+        }
+    }
+    if (solver->config.search_mode == SEARCH_DPLL ||
+        solver->config.decision_strategy == DECISION_JEROSLOW_WANG ||
+        solver->config.decision_strategy == DECISION_MOST_FREQUENT) {
+        solver->jw_scores = safe_calloc(2 * ((size_t)formula->num_variables + 1), sizeof(double));
+        solver->literal_frequency = safe_calloc(2 * ((size_t)formula->num_variables + 1),
+                                                sizeof(uint32_t));
+        solver->track_satisfaction = true;
+        for (size_t i = 0; i < formula->clauses.count; i++) {
+            /* Nenhuma cláusula está satisfeita antes da primeira atribuição */
+            cnf_clause(formula, formula->clauses.refs[i])->true_literals = 0;
+            update_clause_scores(solver, formula->clauses.refs[i], false);
+        }
+    }
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        if (!attach_clause(solver, formula->clauses.refs[i])) {
+            solver_destroy(solver);
+            return NULL;
+        }
+    }
     
     return solver;
 }
 
 void solver_destroy(dpll_solver_t *solver) {
     if (solver) {
+        if (solver->watches) {
+            size_t num_lists = 2 * ((size_t)solver->formula->num_variables + 1);
+            for (size_t i = 0; i < num_lists; i++) {
+                watch_list_dispose(&solver->watches[i]);
+            }
+            free(solver->watches);
+        }
+        free(solver->jw_scores);
+        free(solver->literal_frequency);
         assignment_stack_destroy(solver->assignments);
+        free(solver->trail_position);
+        free(solver->seen);
+        free(solver->learnt_buffer);
+        free(solver->level_stamp);
+        free(solver->activity);
+        var_heap_destroy(solver->order_heap);
         free(solver->pure_literals);
         free(solver->unit_clauses);
+        free(solver->eliminated);
+        literal_vector_dispose(&solver->reconstruction);
         free(solver);
     }
 }
@@ -115,6 +275,13 @@ solver_result_t solver_solve(dpll_solver_t *solver) {
                 solver->formula->num_variables, solver->formula->clauses.count);
     }
     
+    /* Cláusulas unitárias não são observadas: atribuí-las no nível 0 */
+    if (!enqueue_unit_clauses(solver)) {
+        timer_stop(&solver->total_timer);
+        solver->stats.solve_time = timer_elapsed(&solver->total_timer);
+        return SOLVER_UNSATISFIABLE;
+    }
+    
     /* Pré-processamento */
     if (solver->config.enable_preprocessing) {
         if (!preprocess_formula(solver)) {
@@ -123,6 +290,7 @@ solver_result_t solver_solve(dpll_solver_t *solver) {
         
         /* Verificar se já está satisfeito ou insatisfatível após pré-processamento */
         if (solver->formula->clauses.count == 0) {
+            extend_model(solver);
             timer_stop(&solver->total_timer);
             solver->stats.solve_time = timer_elapsed(&solver->total_timer);
             return SOLVER_SATISFIABLE;
@@ -135,16 +303,26 @@ solver_result_t solver_solve(dpll_solver_t *solver) {
         }
     }
     
-    /* Configurar limites de segurança */
-    if (solver->config.timeout_seconds == 0.0) {
-        solver->config.timeout_seconds = 5.0; // 5 segundos padrão
-    }
-    if (solver->config.max_decisions == 0) {
-        solver->config.max_decisions = 1000; // Limite de decisões
+    /* Limites de segurança só para o DPLL recursivo; o CDCL roda sem limite
+     * salvo quando -t/-d são informados */
+    if (solver->config.search_mode != SEARCH_CDCL) {
+        if (solver->config.timeout_seconds == 0.0) {
+            solver->config.timeout_seconds = 5.0; // 5 segundos padrão
+        }
+        if (solver->config.max_decisions == 0) {
+            solver->config.max_decisions = 1000; // Limite de decisões
+        }
     }
     
-    /* Executar algoritmo DPLL */
-    solver_result_t result = dpll_algorithm(solver);
+    /* Executar algoritmo de busca configurado */
+    solver_result_t result = solver->config.search_mode == SEARCH_CDCL
+                                 ? cdcl_algorithm(solver)
+                                 : dpll_algorithm(solver);
+    
+    /* Variáveis eliminadas recebem valores a partir do modelo da fórmula reduzida */
+    if (result == SOLVER_SATISFIABLE) {
+        extend_model(solver);
+    }
     
     timer_stop(&solver->total_timer);
     solver->stats.solve_time = timer_elapsed(&solver->total_timer);
@@ -165,27 +343,25 @@ solver_result_t solver_solve(dpll_solver_t *solver) {
  * @return Resultado da busca: SATISFIABLE, UNSATISFIABLE, UNKNOWN, TIMEOUT ou ERROR
  * 
  * Algoritmo DPLL (Davis-Putnam-Logemann-Loveland):
- * 1. Verifica se a fórmula já está satisfeita
- * 2. Detecta conflitos (cláusulas falsas)
- * 3. Executa propagação unitária
+ * 1. Executa propagação unitária, que também reporta a cláusula em conflito
+ * 2. Faz backtracking em caso de conflito
+ * 3. Verifica se a fórmula está satisfeita (contadores incrementais)
  * 4. Elimina literais puros
  * 5. Escolhe variável para decisão (heurística)
- * 6. Faz backtracking em caso de conflito
  * 
- * Inclui proteções contra loops infinitos e detecção de progresso.
+ * Nenhum passo percorre todas as cláusulas: conflitos vêm da propagação e a
+ * satisfação é mantida por contadores atualizados a cada atribuição.
+ * A propagação roda sempre, pois é ela quem detecta os conflitos.
  */
 solver_result_t dpll_algorithm(dpll_solver_t *solver) {
     if (!solver) return SOLVER_ERROR;
     
     size_t max_iterations = 1000;         ///< Limite de segurança contra loops infinitos
     size_t iterations = 0;                ///< Contador de iterações do loop principal
-    size_t no_progress_rounds = 0;        ///< Detecta iterações sem progresso (livelock)
     
     while (iterations < max_iterations) {
         iterations++;
         SOLVER_TIMEOUT_CHECK(solver);
-        bool progress_made = false;
-        size_t prev_assign_count = solver->assignments->size;
 
         /* Debug: mostrar progresso a cada 100 iterações */
         if (iterations % 100 == 0 && solver->config.verbose) {
@@ -193,63 +369,47 @@ solver_result_t dpll_algorithm(dpll_solver_t *solver) {
                      iterations, solver->stats.decisions, solver->stats.conflicts);
         }
         
-        /* 3. Verificar se fórmula está satisfeita PRIMEIRO */
-        if (is_formula_satisfied(solver)) {
-            return SOLVER_SATISFIABLE;
-        }
-        
-        /* 4. Verificar conflitos */
-        if (has_conflict(solver)) {
+        /* 1-2. Propagação de unidades; conflito leva a backtrack */
+        clause_ref_t conflict = unit_propagation(solver);
+        if (conflict != CLAUSE_REF_UNDEF) {
+            const clause_t *clause = cnf_clause(solver->formula, conflict);
+            
+            /* Sem cláusula aprendida, as médias do glucose usam o LBD da cláusula falsa */
+            if (solver->config.restart_policy == RESTART_GLUCOSE) {
+                restart_on_conflict(solver, compute_lbd(solver, clause->literals, clause->size));
+            }
+            
+            /* Sem análise de conflito, o VSIDS premia as variáveis da cláusula falsa */
+            if (solver->order_heap) {
+                for (size_t k = 0; k < clause->size; k++) {
+                    vsids_bump_variable(solver, literal_variable(clause->literals[k]));
+                }
+                vsids_decay_activities(solver);
+            }
             if (!backtrack(solver)) {
                 return SOLVER_UNSATISFIABLE;
             }
-            progress_made = true; /* backtrack altera o estado */
             continue;
         }
         
-        /* 1. Propagação de unidades */
-        if (solver->config.enable_unit_propagation) {
-            unit_propagation(solver);
-            if (solver->assignments->size > prev_assign_count) {
-                progress_made = true;
-                prev_assign_count = solver->assignments->size;
-            }
-            /* Após propagação, verificar conflitos para permitir backtrack */
-            if (has_conflict(solver)) {
-                if (!backtrack(solver)) {
-                    return SOLVER_UNSATISFIABLE;
-                }
-                progress_made = true;
-                continue;
-            }
+        /* 3. Verificar se fórmula está satisfeita */
+        if (is_formula_satisfied(solver)) {
+            return SOLVER_SATISFIABLE;
         }
         
-        /* 2. Eliminação de literais puros */
+        /* 4. Eliminação de literais puros (nunca gera conflito) */
         if (solver->config.enable_pure_literal) {
-            if (pure_literal_elimination(solver)) {
-                progress_made = true;
-                prev_assign_count = solver->assignments->size;
-            }
-            /* Verificar conflitos também após eliminação de puros */
-            if (has_conflict(solver)) {
-                if (!backtrack(solver)) {
-                    return SOLVER_UNSATISFIABLE;
-                }
-                progress_made = true;
-                continue;
+            pure_literal_elimination(solver);
+            if (is_formula_satisfied(solver)) {
+                return SOLVER_SATISFIABLE;
             }
         }
         
         /* 5. Escolher variável para decisão */
         variable_t decision_var = choose_decision_variable(solver);
         if (decision_var == 0) {
-            /* Todas as variáveis estão atribuídas */
-            if (is_formula_satisfied(solver)) {
-                return SOLVER_SATISFIABLE;
-            } else {
-                /* Sem variáveis livres mas não satisfeita = UNSAT */
-                return SOLVER_UNSATISFIABLE;
-            }
+            /* Todas as variáveis atribuídas após propagação completa sem conflito */
+            return SOLVER_SATISFIABLE;
         }
         
         /* 6. Fazer decisão */
@@ -257,7 +417,6 @@ solver_result_t dpll_algorithm(dpll_solver_t *solver) {
         if (!assign_variable(solver, decision_var, decision_value, true)) {
             return SOLVER_ERROR;
         }
-        progress_made = true;
         
         SOLVER_STATS_INCREMENT(solver, decisions);
         
@@ -270,79 +429,276 @@ solver_result_t dpll_algorithm(dpll_solver_t *solver) {
         /* Verificar se deve reinicializar */
         if (solver->config.enable_restarts && should_restart(solver)) {
             perform_restart(solver);
-            solver->conflicts_since_restart = 0;
-            progress_made = true;
         }
+    }
+    
+    /* Se chegou ao limite de iterações */
+    return SOLVER_TIMEOUT;
+}
 
-        /* Guarda-louça: se nenhuma operação mudou o estado, evite spin infinito */
-        if (!progress_made) {
-            no_progress_rounds++;
-            if (solver->config.verbose) {
-                log_debug("Sem progresso na iteração %zu (rounds=%zu). Encerrando como UNKNOWN para evitar loop.",
-                          iterations, no_progress_rounds);
+/**
+ * @brief Busca CDCL (Conflict-Driven Clause Learning)
+ * @param solver Instância do solver inicializada
+ * @return Resultado da busca: SATISFIABLE, UNSATISFIABLE, UNKNOWN ou TIMEOUT
+ * 
+ * Diferente do DPLL, cada conflito é analisado até o primeiro UIP:
+ * 1. Propaga até o ponto fixo
+ * 2. Em conflito no nível 0, a fórmula é insatisfatível
+ * 3. Em conflito acima do nível 0, aprende uma cláusula assertiva e faz
+ *    backjumping não cronológico até o segundo maior nível da cláusula
+ * 4. Sem conflito, escolhe uma nova variável de decisão
+ * 
+ * Literais puros não são usados durante a busca: atribuições sem razão acima
+ * do nível 0 invalidariam a análise de conflitos.
+ */
+solver_result_t cdcl_algorithm(dpll_solver_t *solver) {
+    if (!solver) return SOLVER_ERROR;
+    
+    while (true) {
+        SOLVER_TIMEOUT_CHECK(solver);
+        
+        clause_ref_t conflict = unit_propagation(solver);
+        if (conflict != CLAUSE_REF_UNDEF) {
+            if (solver->assignments->decision_level == 0) {
+                return SOLVER_UNSATISFIABLE;
+            }
+            
+            size_t backjump_level = 0;
+            size_t size = analyze_conflict(solver, conflict, &backjump_level);
+            /* LBD calculado antes do backjump, com todos os literais ainda atribuídos */
+            uint32_t lbd = compute_lbd(solver, solver->learnt_buffer, size);
+            restart_on_conflict(solver, lbd);
+            vsids_decay_activities(solver);
+            solver->clause_activity_increment /= solver->config.clause_decay;
+            backjump(solver, backjump_level);
+            if (!learn_clause(solver, solver->learnt_buffer, size, lbd)) {
+                return SOLVER_MEMORY_ERROR;
+            }
+            
+            if (solver->stats.conflicts >= solver->next_reduce) {
+                reduce_learnt_clauses(solver);
+            }
+            continue;
+        }
+        
+        /* Atribuições novas no nível 0 satisfazem cláusulas para sempre */
+        if (solver->assignments->decision_level == 0 &&
+            solver->assignments->size > solver->simplified_trail_size) {
+            remove_satisfied_clauses(solver);
+        }
+        
+        /* Reinicializar apenas em pontos fixos sem conflito. O inprocessamento roda
+           nessas fronteiras; sem reinicializações, ele mesmo volta ao nível 0. Uma
+           insatisfatibilidade aparece como conflito na próxima propagação */
+        bool restart = solver->config.enable_restarts && should_restart(solver);
+        if (restart) {
+            perform_restart(solver);
+        }
+        if ((restart || !solver->config.enable_restarts) && inprocessing_due(solver)) {
+            backjump(solver, 0);
+            if (!inprocess_formula(solver)) {
+                return SOLVER_MEMORY_ERROR;
             }
+            continue;
+        }
+        if (restart) {
+            continue;
+        }
+        
+        variable_t decision_var = choose_decision_variable(solver);
+        if (decision_var == 0) {
+            /* Todas as variáveis atribuídas sem conflito */
+            return SOLVER_SATISFIABLE;
+        }
+        
+        var_assignment_t decision_value = choose_decision_value(solver, decision_var);
+        if (!assign_variable(solver, decision_var, decision_value, true)) {
+            return SOLVER_ERROR;
+        }
+        
+        SOLVER_STATS_INCREMENT(solver, decisions);
+        if (solver->assignments->decision_level > solver->stats.max_decision_level) {
+            solver->stats.max_decision_level = solver->assignments->decision_level;
+        }
+        
+        if (solver->config.max_decisions > 0 && 
+            solver->stats.decisions >= solver->config.max_decisions) {
             return SOLVER_UNKNOWN;
-        } else {
-            no_progress_rounds = 0;
         }
     }
-    
-    /* Se chegou ao limite de iterações */
-    return SOLVER_TIMEOUT;
 }
 
 /**
  * @brief Executa propagação unitária (Unit Propagation)
  * @param solver Instância do solver
- * @return SATISFIABLE se todas cláusulas ficaram satisfeitas, UNKNOWN se deve continuar
+ * @return Cláusula com todos os literais falsos, ou CLAUSE_REF_UNDEF sem conflito
  * 
  * Propagação Unitária:
  * - Identifica cláusulas com apenas um literal não atribuído (unit clauses)
  * - Força a atribuição desse literal para satisfazer a cláusula
  * - Repete até não haver mais propagações possíveis
- * - Detecta conflitos quando uma variável precisaria de dois valores diferentes
+ * - Detecta conflitos quando uma cláusula tem todos os literais falsos
  * 
  * É a otimização mais importante do DPLL, reduzindo drasticamente o espaço de busca.
+ * Usa listas de observação: apenas as cláusulas que observam um literal recém
+ * falsificado são visitadas, em vez de todas as cláusulas da fórmula.
+ * O conflito fica registrado em solver->conflict_clause até o próximo backtrack.
  */
-solver_result_t unit_propagation(dpll_solver_t *solver) {
-    if (!solver) return SOLVER_ERROR;
+clause_ref_t unit_propagation(dpll_solver_t *solver) {
+    if (!solver) return CLAUSE_REF_UNDEF;
+    if (solver->conflict_clause != CLAUSE_REF_UNDEF) return solver->conflict_clause;
     
-    bool propagated;
-    do {
-        propagated = false;
+    clause_ref_t conflict = propagate(solver);
+    if (conflict != CLAUSE_REF_UNDEF) {
+        solver->conflict_clause = conflict;
+        solver->conflicts_since_restart++;
+        SOLVER_STATS_INCREMENT(solver, conflicts);
+    }
+    
+    return conflict;
+}
+
+/* ========== Literais Observados (Two-Watched Literals) ========== */
+
+/**
+ * @brief Registra uma cláusula nas listas de observação dos seus dois primeiros literais
+ * @param solver Instância do solver
+ * @param cref Referência da cláusula
+ * @return false apenas em falha de alocação
+ * 
+ * Invariante: os literais observados ficam nas posições 0 e 1 da cláusula.
+ * Cláusulas unitárias (e vazias) não são observadas; são tratadas por
+ * enqueue_unit_clauses().
+ */
+static bool attach_clause(dpll_solver_t *solver, clause_ref_t cref) {
+    const clause_t *clause = cnf_clause(solver->formula, cref);
+    if (clause->size < 2) return true;
+    
+    literal_t first = clause->literals[0];
+    literal_t second = clause->literals[1];
+    return watch_list_push(&solver->watches[literal_index(first)], cref, second) &&
+           watch_list_push(&solver->watches[literal_index(second)], cref, first);
+}
+
+/**
+ * @brief Atribui no nível 0 os literais das cláusulas unitárias da fórmula
+ * @param solver Instância do solver
+ * @return false se a fórmula é trivialmente insatisfatível (cláusula vazia ou
+ *         unitárias contraditórias)
+ */
+static bool enqueue_unit_clauses(dpll_solver_t *solver) {
+    const cnf_formula_t *formula = solver->formula;
+    
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        const clause_t *clause = cnf_clause(formula, formula->clauses.refs[i]);
+        if (clause->size == 0) return false;
+        if (clause->size > 1) continue;
         
-        /* Examinar todas as cláusulas em busca de unit clauses */
-        for (size_t i = 0; i < solver->formula->clauses.count; i++) {
-            clause_t *clause = &solver->formula->clauses.clauses[i];
+        literal_t lit = clause->literals[0];
+        var_assignment_t current = literal_value(formula->assignment, lit);
+        if (current == VAR_FALSE) return false;
+        if (current == VAR_TRUE) continue;
+        
+        if (!assign_variable(solver, literal_variable(lit),
+                             literal_is_positive(lit) ? VAR_TRUE : VAR_FALSE, false)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Propaga todas as atribuições pendentes da pilha usando as listas de observação
+ * @param solver Instância do solver
+ * @return Referência da cláusula em conflito ou CLAUSE_REF_UNDEF
+ * 
+ * Para cada entrada ainda não propagada da pilha, percorre somente as cláusulas
+ * que observam o literal que acabou de ficar falso:
+ * - se o literal bloqueador (ou o outro observado) é verdadeiro, a cláusula é pulada;
+ * - se há outro literal não falso, ele passa a ser observado;
+ * - senão, a cláusula é unitária (propaga) ou conflitante (interrompe).
+ */
+static clause_ref_t propagate(dpll_solver_t *solver) {
+    var_assignment_t *assignment = solver->formula->assignment;
+    assignment_stack_t *trail = solver->assignments;
+    clause_ref_t conflict = CLAUSE_REF_UNDEF;
+    
+    while (solver->propagation_head < trail->size && conflict == CLAUSE_REF_UNDEF) {
+        const assignment_entry_t *entry = &trail->stack[solver->propagation_head++];
+        literal_t false_lit = entry->value == VAR_TRUE ? -entry->variable : entry->variable;
+        watch_list_t *list = &solver->watches[literal_index(false_lit)];
+        solver->stats.ticks += 1 + list->size;
+        
+        watcher_t *i = list->watchers;
+        watcher_t *j = list->watchers;
+        watcher_t *end = list->watchers + list->size;
+        
+        while (i != end) {
+            /* Cláusula já satisfeita pelo bloqueador: nada a fazer */
+            literal_t blocker = i->blocker;
+            if (literal_value(assignment, blocker) == VAR_TRUE) {
+                *j++ = *i++;
+                continue;
+            }
             
-            /* Pular cláusulas já satisfeitas (otimização) */
-            if (clause_is_satisfied(clause, solver->formula->assignment)) {
+            clause_ref_t cref = i->clause;
+            clause_t *clause = cnf_clause(solver->formula, cref);
+            literal_t *lits = clause->literals;
+            i++;
+            
+            /* Cláusula removida: o observador é descartado aqui mesmo */
+            if (clause->deleted) continue;
+            
+            /* Garantir que o literal falso está na posição 1 */
+            if (lits[0] == false_lit) {
+                lits[0] = lits[1];
+                lits[1] = false_lit;
+            }
+            
+            literal_t first = lits[0];
+            if (first != blocker && literal_value(assignment, first) == VAR_TRUE) {
+                j->clause = cref;
+                j->blocker = first;
+                j++;
                 continue;
             }
             
-            literal_t unit_literal;
-            if (clause_is_unit(clause, solver->formula->assignment, &unit_literal)) {
-                variable_t var = literal_variable(unit_literal);
-                var_assignment_t value = literal_is_positive(unit_literal) ? VAR_TRUE : VAR_FALSE;
-                
-                /* Verificar se já está atribuída com valor diferente (conflito) */
-                if (IS_VARIABLE_ASSIGNED(solver, var)) {
-                    if (solver->formula->assignment[var] != value) {
-                        solver->conflicts_since_restart++;
-                        SOLVER_STATS_INCREMENT(solver, conflicts);
-                        /* Não conclui UNSAT aqui; deixe o DPLL fazer backtrack */
-                        return SOLVER_UNKNOWN;
+            /* Procurar um novo literal não falso para observar */
+            bool moved = false;
+            for (size_t k = 2; k < clause->size; k++) {
+                if (literal_value(assignment, lits[k]) != VAR_FALSE) {
+                    lits[1] = lits[k];
+                    lits[k] = false_lit;
+                    /* Falha de alocação aqui não é recuperável */
+                    if (!watch_list_push(&solver->watches[literal_index(lits[1])], cref, first)) {
+                        log_error("Falha ao expandir lista de observação");
+                        exit(EXIT_FAILURE);
                     }
-                    continue; /* Já atribuída corretamente */
+                    moved = true;
+                    break;
                 }
-                
-                /* Propagar */
-                if (!assign_variable(solver, var, value, false)) {
-                    return SOLVER_MEMORY_ERROR;
+            }
+            if (moved) continue;
+            
+            /* Cláusula unitária ou conflitante: continua observando false_lit */
+            j->clause = cref;
+            j->blocker = first;
+            j++;
+            
+            if (literal_value(assignment, first) == VAR_FALSE) {
+                conflict = cref;
+                while (i != end) {
+                    *j++ = *i++;
+                }
+            } else {
+                variable_t var = literal_variable(first);
+                var_assignment_t value = literal_is_positive(first) ? VAR_TRUE : VAR_FALSE;
+                if (!push_assignment(solver, var, value, false, cref)) {
+                    log_error("Falha ao empilhar propagação");
+                    exit(EXIT_FAILURE);
                 }
-                
                 SOLVER_STATS_INCREMENT(solver, propagations);
-                propagated = true;
                 solver->formula_modified = true;
                 
                 if (solver->config.verbose) {
@@ -350,56 +706,34 @@ solver_result_t unit_propagation(dpll_solver_t *solver) {
                 }
             }
         }
-    } while (propagated);
-    
-    /* Se todas as cláusulas ficaram satisfeitas no processo, reportar SAT */
-    if (cnf_is_satisfied(solver->formula)) {
-        return SOLVER_SATISFIABLE;
+        
+        list->size = (size_t)(j - list->watchers);
     }
-    return SOLVER_UNKNOWN; /* Continuar algoritmo */
+    
+    return conflict;
 }
 
+/**
+ * @brief Atribui os literais puros: variáveis que aparecem em uma só polaridade
+ *        entre as cláusulas não satisfeitas
+ * @param solver Instância do solver
+ * @return true se alguma variável foi atribuída
+ * 
+ * Com os contadores de frequência, cada variável é testada em O(1); sem eles,
+ * percorre apenas as listas de ocorrências da variável.
+ */
 bool pure_literal_elimination(dpll_solver_t *solver) {
     if (!solver) return false;
     bool changed = false;
     
-    /* Marcar todas as variáveis como candidatas a literais puros */
     for (variable_t var = 1; var <= solver->formula->num_variables; var++) {
         if (IS_VARIABLE_ASSIGNED(solver, var)) {
             solver->pure_literals[var] = false;
             continue;
         }
         
-        bool appears_positive = false;
-        bool appears_negative = false;
-        
-        /* Verificar em todas as cláusulas não satisfeitas */
-        for (size_t i = 0; i < solver->formula->clauses.count; i++) {
-            clause_t *clause = &solver->formula->clauses.clauses[i];
-            
-            if (clause_is_satisfied(clause, solver->formula->assignment)) {
-                continue;
-            }
-            
-            for (size_t j = 0; j < clause->size; j++) {
-                literal_t lit = clause->literals[j];
-                if (literal_variable(lit) == var) {
-                    if (literal_is_positive(lit)) {
-                        appears_positive = true;
-                    } else {
-                        appears_negative = true;
-                    }
-                    
-                    if (appears_positive && appears_negative) {
-                        break; /* Não é puro */
-                    }
-                }
-            }
-            
-            if (appears_positive && appears_negative) {
-                break;
-            }
-        }
+        bool appears_positive = calculate_literal_frequency(solver, var) > 0;
+        bool appears_negative = calculate_literal_frequency(solver, -var) > 0;
         
         /* Se aparece apenas em uma polaridade, é literal puro */
         if (appears_positive && !appears_negative) {
@@ -422,6 +756,258 @@ bool pure_literal_elimination(dpll_solver_t *solver) {
     return changed;
 }
 
+/* ========== Aprendizado de Cláusulas ========== */
+
+/**
+ * @brief Análise de conflito pelo esquema do primeiro UIP (Unique Implication Point)
+ * @param solver Instância do solver (nível de decisão atual > 0)
+ * @param conflict Cláusula com todos os literais falsos
+ * @param backjump_level Saída: nível para onde voltar
+ * @return Tamanho da cláusula aprendida, escrita em solver->learnt_buffer
+ * 
+ * Resolve a cláusula de conflito com as razões dos literais do nível atual,
+ * percorrendo a pilha de trás para frente, até restar um único literal desse
+ * nível (o UIP). A posição 0 recebe a negação do UIP (literal assertivo) e a
+ * posição 1 o literal de maior nível entre os demais, que define o backjump.
+ */
+size_t analyze_conflict(dpll_solver_t *solver, clause_ref_t conflict, size_t *backjump_level) {
+    const assignment_stack_t *trail = solver->assignments;
+    size_t current_level = trail->decision_level;
+    literal_t *learnt = solver->learnt_buffer;
+    size_t size = 1;                      /* posição 0 reservada para o UIP */
+    size_t pending = 0;                   /* literais do nível atual ainda não resolvidos */
+    size_t index = trail->size;
+    literal_t uip = 0;
+    clause_ref_t reason = conflict;
+    
+    do {
+        clause_t *clause = cnf_clause(solver->formula, reason);
+        if (clause->learnt) {
+            bump_learnt_clause(solver, clause);
+        }
+        /* Na razão, a posição 0 é o próprio literal propagado */
+        for (size_t k = (uip == 0) ? 0 : 1; k < clause->size; k++) {
+            literal_t lit = clause->literals[k];
+            variable_t var = literal_variable(lit);
+            size_t level = trail->stack[solver->trail_position[var]].decision_level;
+            
+            if (solver->seen[var] || level == 0) continue;
+            solver->seen[var] = true;
+            vsids_bump_variable(solver, var);
+            if (level >= current_level) {
+                pending++;
+            } else {
+                learnt[size++] = lit;
+            }
+        }
+        
+        /* Próximo literal marcado na pilha */
+        do {
+            index--;
+        } while (!solver->seen[trail->stack[index].variable]);
+        
+        const assignment_entry_t *entry = &trail->stack[index];
+        uip = entry->value == VAR_TRUE ? entry->variable : -entry->variable;
+        reason = entry->reason;
+        solver->seen[entry->variable] = false;
+        pending--;
+    } while (pending > 0);
+    
+    learnt[0] = -uip;
+    
+    /* Limpar marcas e escolher o literal de maior nível para a posição 1 */
+    size_t max_index = 1;
+    *backjump_level = 0;
+    for (size_t k = 1; k < size; k++) {
+        variable_t var = literal_variable(learnt[k]);
+        size_t level = trail->stack[solver->trail_position[var]].decision_level;
+        solver->seen[var] = false;
+        if (level > *backjump_level) {
+            *backjump_level = level;
+            max_index = k;
+        }
+    }
+    if (size > 1) {
+        SWAP(learnt[1], learnt[max_index], literal_t);
+    }
+    
+    return size;
+}
+
+/**
+ * @brief Número de níveis de decisão distintos entre os literais (LBD, ou glue)
+ * 
+ * Todos os literais devem estar atribuídos. Usa uma marca por nível em vez
+ * de limpar um array a cada chamada.
+ */
+static uint32_t compute_lbd(dpll_solver_t *solver, const literal_t *literals, size_t size) {
+    if (++solver->stamp_counter == 0) {
+        memset(solver->level_stamp, 0,
+               ((size_t)solver->formula->num_variables + 1) * sizeof(uint32_t));
+        solver->stamp_counter = 1;
+    }
+    
+    const assignment_stack_t *trail = solver->assignments;
+    uint32_t lbd = 0;
+    for (size_t k = 0; k < size; k++) {
+        variable_t var = literal_variable(literals[k]);
+        size_t level = trail->stack[solver->trail_position[var]].decision_level;
+        if (solver->level_stamp[level] != solver->stamp_counter) {
+            solver->level_stamp[level] = solver->stamp_counter;
+            lbd++;
+        }
+    }
+    
+    return lbd;
+}
+
+/* Camada de uma cláusula aprendida com o LBD dado */
+static clause_tier_t tier_for_lbd(const dpll_solver_t *solver, uint32_t lbd) {
+    if (lbd <= solver->config.core_lbd) return CLAUSE_TIER_CORE;
+    if (lbd <= solver->config.tier2_lbd) return CLAUSE_TIER_MID;
+    return CLAUSE_TIER_LOCAL;
+}
+
+/**
+ * @brief Registra o uso de uma aprendida na análise de um conflito
+ * 
+ * Marca a cláusula como usada, aumenta sua atividade (reescalando todas
+ * quando o float se aproxima do limite) e recalcula o LBD: se caiu, a
+ * cláusula pode subir de camada, nunca descer.
+ */
+static void bump_learnt_clause(dpll_solver_t *solver, clause_t *clause) {
+    clause->used = true;
+    
+    clause->activity += (float)solver->clause_activity_increment;
+    if (clause->activity > 1e20f) {
+        cnf_formula_t *formula = solver->formula;
+        for (size_t i = 0; i < formula->clauses.count; i++) {
+            clause_t *other = cnf_clause(formula, formula->clauses.refs[i]);
+            if (other->learnt) {
+                other->activity *= 1e-20f;
+            }
+        }
+        solver->clause_activity_increment *= 1e-20;
+    }
+    
+    if (clause->tier != CLAUSE_TIER_CORE) {
+        uint32_t lbd = compute_lbd(solver, clause->literals, clause->size);
+        if (lbd < clause->lbd) {
+            clause->lbd = lbd;
+            clause_tier_t tier = tier_for_lbd(solver, lbd);
+            if (tier < (clause_tier_t)clause->tier) {
+                clause->tier = tier;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Registra a cláusula aprendida e atribui seu literal assertivo
+ * @param solver Instância do solver, já no nível de backjump
+ * @param literals Literais da cláusula (posição 0 = assertivo)
+ * @param size Número de literais
+ * @param lbd LBD da cláusula, que define sua camada inicial
+ * @return false em falha de alocação
+ * 
+ * Cláusulas unitárias não são armazenadas: o literal é fixado no nível 0.
+ */
+bool learn_clause(dpll_solver_t *solver, const literal_t *literals, size_t size, uint32_t lbd) {
+    literal_t asserting = literals[0];
+    var_assignment_t value = literal_is_positive(asserting) ? VAR_TRUE : VAR_FALSE;
+    clause_ref_t cref = CLAUSE_REF_UNDEF;
+    
+    if (size > 1) {
+        cref = cnf_add_clause_literals(solver->formula, literals, size, true);
+        if (cref == CLAUSE_REF_UNDEF) return false;
+        
+        clause_t *clause = cnf_clause(solver->formula, cref);
+        clause->lbd = lbd;
+        clause->tier = tier_for_lbd(solver, lbd);
+        clause->activity = (float)solver->clause_activity_increment;
+        if (!attach_clause(solver, cref)) return false;
+    }
+    
+    SOLVER_STATS_INCREMENT(solver, learned_clauses);
+    return push_assignment(solver, literal_variable(asserting), value, false, cref);
+}
+
+/* Candidata à remoção na redução da camada local */
+typedef struct {
+    float activity;
+    clause_ref_t cref;
+} reduce_candidate_t;
+
+static int compare_reduce_candidates(const void *a, const void *b) {
+    float x = ((const reduce_candidate_t*)a)->activity;
+    float y = ((const reduce_candidate_t*)b)->activity;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Reduz a base de cláusulas aprendidas
+ * @param solver Instância do solver
+ * 
+ * - core: nunca removida;
+ * - intermediária: desce para a local se não foi usada desde a última redução;
+ * - local: a metade menos ativa é removida.
+ * Razões de atribuições na pilha nunca são removidas. O intervalo até a
+ * próxima redução cresce de config.reduce_increment a cada chamada.
+ */
+void reduce_learnt_clauses(dpll_solver_t *solver) {
+    if (!solver) return;
+    
+    cnf_formula_t *formula = solver->formula;
+    reduce_candidate_t *candidates = safe_malloc((formula->learnt_count + 1) *
+                                                 sizeof(reduce_candidate_t));
+    size_t num_candidates = 0;
+    
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        clause_ref_t cref = formula->clauses.refs[i];
+        clause_t *clause = cnf_clause(formula, cref);
+        if (!clause->learnt || clause->deleted) continue;
+        
+        if (clause->tier == CLAUSE_TIER_MID && !clause->used) {
+            clause->tier = CLAUSE_TIER_LOCAL;
+        } else if (clause->tier == CLAUSE_TIER_LOCAL && !clause_is_locked(solver, cref)) {
+            candidates[num_candidates].activity = clause->activity;
+            candidates[num_candidates].cref = cref;
+            num_candidates++;
+        }
+        clause->used = false;
+    }
+    
+    qsort(candidates, num_candidates, sizeof(reduce_candidate_t), compare_reduce_candidates);
+    size_t to_delete = num_candidates / 2;
+    for (size_t k = 0; k < to_delete; k++) {
+        cnf_delete_clause(formula, candidates[k].cref);
+    }
+    free(candidates);
+    
+    /* Retirar as removidas da lista da fórmula */
+    size_t kept = 0;
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        clause_ref_t cref = formula->clauses.refs[i];
+        if (!cnf_clause(formula, cref)->deleted) {
+            formula->clauses.refs[kept++] = cref;
+        }
+    }
+    formula->clauses.count = kept;
+    
+    SOLVER_STATS_INCREMENT(solver, reductions);
+    solver->stats.deleted_clauses += to_delete;
+    solver->stats.kept_clauses = formula->learnt_count;
+    solver->reduce_interval += solver->config.reduce_increment;
+    solver->next_reduce = solver->stats.conflicts + solver->reduce_interval;
+    
+    if (solver->config.verbose) {
+        log_debug("Redução: %zu aprendidas removidas, %zu mantidas",
+                  to_delete, formula->learnt_count);
+    }
+    
+    check_garbage(solver);
+}
+
 /* ========== Funções de Decisão ========== */
 
 variable_t choose_decision_variable(dpll_solver_t *solver) {
@@ -436,6 +1022,8 @@ variable_t choose_decision_variable(dpll_solver_t *solver) {
             return decision_jeroslow_wang(solver);
         case DECISION_RANDOM:
             return decision_random(solver);
+        case DECISION_VSIDS:
+            return decision_vsids(solver);
         default:
             return decision_first_unassigned(solver);
     }
@@ -452,7 +1040,7 @@ variable_t decision_first_unassigned(const dpll_solver_t *solver) {
     if (!solver) return 0;
     
     for (variable_t var = 1; var <= solver->formula->num_variables; var++) {
-        if (!IS_VARIABLE_ASSIGNED(solver, var)) {
+        if (!IS_VARIABLE_ASSIGNED(solver, var) && !IS_VARIABLE_ELIMINATED(solver, var)) {
             return var;
         }
     }
@@ -467,7 +1055,7 @@ variable_t decision_most_frequent(const dpll_solver_t *solver) {
     size_t max_frequency = 0;
     
     for (variable_t var = 1; var <= solver->formula->num_variables; var++) {
-        if (IS_VARIABLE_ASSIGNED(solver, var)) continue;
+        if (IS_VARIABLE_ASSIGNED(solver, var) || IS_VARIABLE_ELIMINATED(solver, var)) continue;
         
         size_t pos_freq = calculate_literal_frequency(solver, var);
         size_t neg_freq = calculate_literal_frequency(solver, -var);
@@ -489,7 +1077,7 @@ variable_t decision_jeroslow_wang(const dpll_solver_t *solver) {
     double max_score = -1.0;
     
     for (variable_t var = 1; var <= solver->formula->num_variables; var++) {
-        if (IS_VARIABLE_ASSIGNED(solver, var)) continue;
+        if (IS_VARIABLE_ASSIGNED(solver, var) || IS_VARIABLE_ELIMINATED(solver, var)) continue;
         
         double score = calculate_jeroslow_wang_score(solver, var);
         if (score > max_score) {
@@ -509,7 +1097,7 @@ variable_t decision_random(const dpll_solver_t *solver) {
     size_t unassigned_count = 0;
     
     for (variable_t var = 1; var <= solver->formula->num_variables; var++) {
-        if (!IS_VARIABLE_ASSIGNED(solver, var)) {
+        if (!IS_VARIABLE_ASSIGNED(solver, var) && !IS_VARIABLE_ELIMINATED(solver, var)) {
             unassigned_vars[unassigned_count++] = var;
         }
     }
@@ -520,6 +1108,27 @@ variable_t decision_random(const dpll_solver_t *solver) {
     return unassigned_vars[random_index];
 }
 
+/**
+ * @brief Escolhe a variável livre de maior atividade (VSIDS)
+ * @param solver Instância do solver
+ * @return Variável escolhida ou 0 se todas estão atribuídas
+ * 
+ * Variáveis atribuídas saem do heap preguiçosamente aqui e voltam a ele
+ * quando são desatribuídas no backjump; as eliminadas saem de vez.
+ */
+variable_t decision_vsids(dpll_solver_t *solver) {
+    if (!solver || !solver->order_heap) return decision_first_unassigned(solver);
+    
+    while (solver->order_heap->size > 0) {
+        variable_t var = var_heap_pop(solver->order_heap);
+        if (!IS_VARIABLE_ASSIGNED(solver, var) && !IS_VARIABLE_ELIMINATED(solver, var)) {
+            return var;
+        }
+    }
+    
+    return 0; /* Todas atribuídas */
+}
+
 /* ========== Backtracking ========== */
 
 /**
@@ -593,20 +1202,9 @@ bool backtrack(dpll_solver_t *solver) {
                   last_decision_idx, solver->assignments->size);
     }
 
-    // desempilha (sem usar pop) todas as entradas acima da decisão
-    size_t cur_size = solver->assignments->size;
-    for (size_t i = cur_size; i > (size_t)last_decision_idx + 1; --i) {
-        assignment_entry_t entry = solver->assignments->stack[i - 1];
-        // limpar atribuição na fórmula
-        solver->formula->assignment[entry.variable] = VAR_UNASSIGNED;
-        // reduzir tamanho da pilha
-        solver->assignments->size--;
-    }
-
-    // agora desempilha a própria decisão (último elemento restante)
-    assignment_entry_t decision_entry = solver->assignments->stack[solver->assignments->size - 1];
-    solver->formula->assignment[decision_entry.variable] = VAR_UNASSIGNED;
-    solver->assignments->size--;
+    // desfaz a decisão e tudo acima dela: O(1) por variável desatribuída
+    assignment_entry_t decision_entry = solver->assignments->stack[last_decision_idx];
+    backjump(solver, decision_entry.decision_level - 1);
 
     // inverter o valor da decisão e reatribuir COMO decisão
     var_assignment_t opposite_value = (decision_entry.value == VAR_TRUE) ? VAR_FALSE : VAR_TRUE;
@@ -631,13 +1229,80 @@ bool backtrack(dpll_solver_t *solver) {
     return true;
 }
 
+/**
+ * @brief Desfaz todas as atribuições acima de um nível (backjumping não cronológico)
+ * @param solver Instância do solver
+ * @param level Nível que permanece atribuído
+ * 
+ * Percorre apenas as entradas removidas da pilha: O(1) por variável desatribuída.
+ */
+void backjump(dpll_solver_t *solver, size_t level) {
+    if (!solver || solver->assignments->decision_level <= level) return;
+    
+    const assignment_stack_t *trail = solver->assignments;
+    for (size_t i = trail->size; i > 0 && trail->stack[i - 1].decision_level > level; --i) {
+        const assignment_entry_t *entry = &trail->stack[i - 1];
+        
+        if (solver->track_satisfaction) {
+            literal_t lit = entry->value == VAR_TRUE ? entry->variable : -entry->variable;
+            size_t count;
+            const clause_ref_t *occ = cnf_occurrences(solver->formula, lit, &count);
+            for (size_t k = 0; k < count; k++) {
+                clause_t *clause = cnf_clause(solver->formula, occ[k]);
+                if (clause->deleted) continue;
+                if (--clause->true_literals == 0) {
+                    solver->formula->satisfied_clauses--;
+                    update_clause_scores(solver, occ[k], false);
+                }
+            }
+        }
+        solver->formula->assignment[entry->variable] = VAR_UNASSIGNED;
+        solver->assigned_count--;
+        if (solver->order_heap) {
+            var_heap_insert(solver->order_heap, entry->variable);
+        }
+    }
+    
+    assignment_stack_backtrack_to_level(solver->assignments, level);
+    if (solver->propagation_head > solver->assignments->size) {
+        solver->propagation_head = solver->assignments->size;
+    }
+    solver->conflict_clause = CLAUSE_REF_UNDEF;
+}
+
 /* ========== Funções Auxiliares ========== */
 
 bool assign_variable(dpll_solver_t *solver, variable_t var, var_assignment_t value, bool is_decision) {
     if (!solver || var == 0 || var > solver->formula->num_variables) return false;
     
-    solver->formula->assignment[var] = value;
-    bool pushed = assignment_stack_push(solver->assignments, var, value, is_decision);
+    return push_assignment(solver, var, value, is_decision, CLAUSE_REF_UNDEF);
+}
+
+/**
+ * @brief Atribui uma variável registrando a cláusula razão (se houver)
+ */
+static bool push_assignment(dpll_solver_t *solver, variable_t var, var_assignment_t value,
+                            bool is_decision, clause_ref_t reason) {
+    solver->trail_position[var] = solver->assignments->size;
+    bool pushed = assignment_stack_push(solver->assignments, var, value, is_decision, reason);
+    if (pushed) {
+        solver->formula->assignment[var] = value;
+        solver->assigned_count++;
+        
+        if (solver->track_satisfaction) {
+            size_t count;
+            const clause_ref_t *occ = cnf_occurrences(solver->formula, value == VAR_TRUE ? var : -var,
+                                                      &count);
+            for (size_t k = 0; k < count; k++) {
+                clause_t *clause = cnf_clause(solver->formula, occ[k]);
+                if (clause->deleted) continue;
+                if (clause->true_literals++ == 0) {
+                    solver->formula->satisfied_clauses++;
+                    update_clause_scores(solver, occ[k], true);
+                }
+            }
+        }
+    }
     if (!pushed) {
         if (solver->config.verbose) {
             log_error("Falha ao empilhar atribuição x%d=%s (%s)",
@@ -656,23 +1321,35 @@ bool assign_variable(dpll_solver_t *solver, variable_t var, var_assignment_t val
     return true;
 }
 
+/**
+ * @brief Indica se a última propagação encontrou uma cláusula falsa
+ * 
+ * Conflitos só surgem ao propagar (decisões e literais puros nunca falsificam
+ * uma cláusula inteira após propagação completa), então basta consultar o
+ * conflito registrado por unit_propagation().
+ */
 bool has_conflict(const dpll_solver_t *solver) {
     if (!solver) return false;
     
-    for (size_t i = 0; i < solver->formula->clauses.count; i++) {
-        if (clause_is_conflicting(&solver->formula->clauses.clauses[i], 
-                                  solver->formula->assignment)) {
-            return true;
-        }
-    }
-    
-    return false;
+    return solver->conflict_clause != CLAUSE_REF_UNDEF;
 }
 
+/**
+ * @brief Indica se a atribuição atual satisfaz a fórmula
+ * 
+ * No DPLL usa o contador de cláusulas satisfeitas, permitindo parar com
+ * atribuição parcial. Sem esse contador, a fórmula está satisfeita quando
+ * todas as variáveis não eliminadas foram atribuídas com propagação
+ * completa e sem conflito.
+ */
 bool is_formula_satisfied(const dpll_solver_t *solver) {
-    if (!solver) return false;
+    if (!solver || solver->conflict_clause != CLAUSE_REF_UNDEF) return false;
     
-    return cnf_is_satisfied(solver->formula);
+    if (solver->track_satisfaction) {
+        return solver->formula->satisfied_clauses == solver->original_clauses;
+    }
+    return solver->assigned_count + solver->eliminated_count == solver->formula->num_variables &&
+           solver->propagation_head == solver->assignments->size;
 }
 
 bool solver_is_timeout(const dpll_solver_t *solver) {
@@ -684,59 +1361,126 @@ bool solver_is_timeout(const dpll_solver_t *solver) {
 
 /* ========== Heurísticas ========== */
 
+/**
+ * @brief Score Jeroslow-Wang de uma variável: soma de 2^-|C| sobre as cláusulas
+ *        não satisfeitas que a contêm (em qualquer polaridade)
+ * 
+ * Com contadores incrementais é O(1); sem eles, percorre as listas de
+ * ocorrências das duas polaridades da variável.
+ */
 double calculate_jeroslow_wang_score(const dpll_solver_t *solver, variable_t var) {
     if (!solver || var == 0) return 0.0;
     
+    if (solver->jw_scores) {
+        return solver->jw_scores[literal_index(var)] + solver->jw_scores[literal_index(-var)];
+    }
+    
     double score = 0.0;
+    literal_t polarities[2] = { var, -var };
     
-    for (size_t i = 0; i < solver->formula->clauses.count; i++) {
-        const clause_t *clause = &solver->formula->clauses.clauses[i];
-        
-        if (clause_is_satisfied(clause, solver->formula->assignment)) {
-            continue;
-        }
-        
-        bool contains_var = false;
-        for (size_t j = 0; j < clause->size; j++) {
-            if (literal_variable(clause->literals[j]) == var) {
-                contains_var = true;
-                break;
+    for (int p = 0; p < 2; p++) {
+        size_t count;
+        const clause_ref_t *occ = cnf_occurrences(solver->formula, polarities[p], &count);
+        for (size_t i = 0; i < count; i++) {
+            const clause_t *clause = cnf_clause(solver->formula, occ[i]);
+            if (!clause_is_satisfied(clause, solver->formula->assignment)) {
+                score += jw_weight(clause->size);
             }
         }
-        
-        if (contains_var) {
-            score += pow(2.0, -(double)clause->size);
-        }
     }
     
     return score;
 }
 
+/**
+ * @brief Número de cláusulas não satisfeitas que contêm o literal
+ * 
+ * Com contadores incrementais é O(1); sem eles, percorre a lista de
+ * ocorrências do literal.
+ */
 size_t calculate_literal_frequency(const dpll_solver_t *solver, literal_t literal) {
     if (!solver) return 0;
     
+    if (solver->literal_frequency) {
+        return solver->literal_frequency[literal_index(literal)];
+    }
+    
     size_t frequency = 0;
+    size_t count;
+    const clause_ref_t *occ = cnf_occurrences(solver->formula, literal, &count);
     
-    for (size_t i = 0; i < solver->formula->clauses.count; i++) {
-        const clause_t *clause = &solver->formula->clauses.clauses[i];
-        
-        if (clause_is_satisfied(clause, solver->formula->assignment)) {
-            continue;
-        }
-        
-        for (size_t j = 0; j < clause->size; j++) {
-            if (clause->literals[j] == literal) {
-                frequency++;
-                break;
-            }
+    for (size_t i = 0; i < count; i++) {
+        if (!clause_is_satisfied(cnf_clause(solver->formula, occ[i]),
+                                 solver->formula->assignment)) {
+            frequency++;
         }
     }
     
     return frequency;
 }
 
+/**
+ * @brief Atualiza os scores por literal quando uma cláusula original muda de estado
+ * @param solver Instância do solver
+ * @param cref Cláusula que acabou de ficar satisfeita ou de deixar de estar
+ * @param satisfied true ao ficar satisfeita (remove a contribuição), false ao voltar
+ * 
+ * Chamada apenas nas transições 0 <-> 1 literal verdadeiro, então cada
+ * atribuição custa o tamanho das cláusulas que ela satisfaz pela primeira vez.
+ */
+static void update_clause_scores(dpll_solver_t *solver, clause_ref_t cref, bool satisfied) {
+    const clause_t *clause = cnf_clause(solver->formula, cref);
+    double weight = jw_weight(clause->size);
+    
+    for (size_t k = 0; k < clause->size; k++) {
+        size_t index = literal_index(clause->literals[k]);
+        if (satisfied) {
+            solver->jw_scores[index] -= weight;
+            solver->literal_frequency[index]--;
+        } else {
+            solver->jw_scores[index] += weight;
+            solver->literal_frequency[index]++;
+        }
+    }
+}
+
+/**
+ * @brief Aumenta a atividade de uma variável envolvida em um conflito
+ * 
+ * Em vez de decair todas as atividades a cada conflito, o incremento cresce
+ * geometricamente; quando os valores se aproximam do limite do double, todos
+ * são reescalados juntos, preservando a ordem.
+ */
+void vsids_bump_variable(dpll_solver_t *solver, variable_t var) {
+    if (!solver || !solver->order_heap) return;
+    
+    solver->activity[var] += solver->activity_increment;
+    if (solver->activity[var] > 1e100) {
+        for (variable_t v = 1; v <= solver->formula->num_variables; v++) {
+            solver->activity[v] *= 1e-100;
+        }
+        solver->activity_increment *= 1e-100;
+    }
+    
+    var_heap_increase(solver->order_heap, var);
+}
+
+/**
+ * @brief Decaimento exponencial: conflitos futuros valem mais que os passados
+ */
+void vsids_decay_activities(dpll_solver_t *solver) {
+    if (!solver || !solver->order_heap) return;
+    
+    solver->activity_increment /= solver->config.vsids_decay;
+}
+
 /* ========== Pré-processamento ========== */
 
+/* Esforço da sondagem no pré-processamento: ticks de propagação por palavra da arena */
+#define PROBE_EFFORT 0.2
+/* Esforço mínimo da sondagem, para fórmulas pequenas */
+#define PROBE_MIN_TICKS 1000000ULL
+
 bool preprocess_formula(dpll_solver_t *solver) {
     if (!solver) return false;
     
@@ -750,43 +1494,814 @@ bool preprocess_formula(dpll_solver_t *solver) {
             changed = true;
         }
 
-        /* Propagar unidades */
-        unit_propagation(solver);
+        /* Propagar unidades; conflito no nível 0 será tratado pelo chamador */
+        if (unit_propagation(solver) != CLAUSE_REF_UNDEF) {
+            return true;
+        }
 
         /* Detectar alterações via tamanho da pilha de atribuições */
         if (solver->assignments->size != before) {
             changed = true;
         }
 
-        /* Verificar conflito explícito */
+    } while (changed);
+    
+    remove_satisfied_clauses(solver);
+    
+    /* Sondagem: literais falhos viram unitárias, hiper-binárias entram como aprendidas */
+    if (solver->config.enable_probing) {
+        uint64_t budget = PROBE_MIN_TICKS + (uint64_t)(PROBE_EFFORT * solver->formula->arena.size);
+        if (!probe_literals(solver, budget)) {
+            return false;
+        }
         if (has_conflict(solver)) {
-            return true; /* será tratado pelo chamador */
+            return true;
         }
+        remove_satisfied_clauses(solver);
+    }
+    
+    /* Equivalências, subsunção, bloqueadas e eliminação; unitárias são propagadas de novo */
+    if (solver->config.enable_equivalences || solver->config.enable_subsumption ||
+        solver->config.enable_blocked || solver->config.enable_elimination) {
+        if (!simplify_clauses(solver, SIMPLIFY_UNLIMITED, SIMPLIFY_UNLIMITED)) {
+            return false;
+        }
+        if (unit_propagation(solver) != CLAUSE_REF_UNDEF) {
+            return true;
+        }
+        remove_satisfied_clauses(solver);
+    }
+    return true;
+}
 
-    } while (changed);
+/**
+ * @brief Simplifica a base de cláusulas no nível 0 com listas de ocorrências
+ * @param solver Instância do solver, no nível 0 e com a propagação completa
+ * @param subsume_budget Literais visitados pela subsunção (zero a pula)
+ * @param elim_budget Literais visitados pela eliminação (zero a pula)
+ * @return false apenas em falha de alocação
+ * 
+ * Executa substituição de equivalentes, subsunção, eliminação de
+ * cláusulas bloqueadas e de variáveis (BVE), conforme a configuração e os
+ * orçamentos, e reconstrói as estruturas da busca. Se a simplificação deriva a cláusula vazia, ela é adicionada à
+ * fórmula e registrada como conflito, que o chamador vê em has_conflict().
+ */
+bool simplify_clauses(dpll_solver_t *solver, uint64_t subsume_budget, uint64_t elim_budget) {
+    if (!solver || solver->assignments->decision_level > 0) return true;
+    if (solver->conflict_clause != CLAUSE_REF_UNDEF) return true;
     
+    /* Contadores de satisfação são recalculados na reconstrução */
+    bool track_satisfaction = solver->track_satisfaction;
+    solver->track_satisfaction = false;
+    bool consistent = simplify_occurrences(solver, subsume_budget, elim_budget);
+    solver->track_satisfaction = track_satisfaction;
+    
+    if (!rebuild_search_structures(solver)) {
+        return false;
+    }
+    if (!consistent) {
+        clause_ref_t empty = cnf_add_clause_literals(solver->formula, NULL, 0, false);
+        if (empty == CLAUSE_REF_UNDEF) return false;
+        solver->conflict_clause = empty;
+    }
     return true;
 }
 
+/**
+ * @brief Refaz listas de observação, ocorrências e contadores após a simplificação
+ * @param solver Instância do solver, no nível 0
+ * @return false em falha de alocação
+ * 
+ * Aprendidas que citam variáveis eliminadas são descartadas. Todas as
+ * cláusulas voltam a ser observadas nos dois primeiros literais e a
+ * propagação recomeça do início da pilha: os observadores de literais já
+ * falsos no nível 0 são revisitados e trocados, como em qualquer propagação.
+ */
+static bool rebuild_search_structures(dpll_solver_t *solver) {
+    cnf_formula_t *formula = solver->formula;
+    
+    size_t kept = 0;
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        clause_ref_t cref = formula->clauses.refs[i];
+        clause_t *clause = cnf_clause(formula, cref);
+        if (clause->deleted) continue;
+        if (clause->learnt) {
+            bool eliminated = false;
+            for (size_t k = 0; k < clause->size && !eliminated; k++) {
+                eliminated = IS_VARIABLE_ELIMINATED(solver, literal_variable(clause->literals[k]));
+            }
+            if (eliminated) {
+                cnf_delete_clause(formula, cref);
+                continue;
+            }
+        }
+        formula->clauses.refs[kept++] = cref;
+    }
+    formula->clauses.count = kept;
+    
+    if (!cnf_build_occurrence_lists(formula)) return false;
+    
+    /* Contadores de satisfação e scores, como na criação do solver */
+    size_t num_literals = 2 * ((size_t)formula->num_variables + 1);
+    solver->original_clauses = 0;
+    formula->satisfied_clauses = 0;
+    if (solver->track_satisfaction) {
+        memset(solver->jw_scores, 0, num_literals * sizeof(double));
+        memset(solver->literal_frequency, 0, num_literals * sizeof(uint32_t));
+    }
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        clause_t *clause = cnf_clause(formula, formula->clauses.refs[i]);
+        if (clause->learnt) continue;
+        solver->original_clauses++;
+        if (!solver->track_satisfaction) continue;
+        
+        clause->true_literals = 0;
+        for (size_t k = 0; k < clause->size; k++) {
+            if (literal_value(formula->assignment, clause->literals[k]) == VAR_TRUE) {
+                clause->true_literals++;
+            }
+        }
+        if (clause->true_literals > 0) {
+            formula->satisfied_clauses++;
+        } else {
+            update_clause_scores(solver, formula->clauses.refs[i], false);
+        }
+    }
+    
+    for (size_t l = 0; l < num_literals; l++) {
+        solver->watches[l].size = 0;
+    }
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        if (!attach_clause(solver, formula->clauses.refs[i])) return false;
+    }
+    solver->propagation_head = 0;
+    
+    check_garbage(solver);
+    return true;
+}
+
+/**
+ * @brief Indica se a cláusula é a razão de uma atribuição na pilha
+ * 
+ * A razão de uma propagação sempre tem o literal implicado na posição 0.
+ */
+static bool clause_is_locked(const dpll_solver_t *solver, clause_ref_t cref) {
+    const clause_t *clause = cnf_clause(solver->formula, cref);
+    if (clause->size == 0) return false;
+    
+    literal_t first = clause->literals[0];
+    if (literal_value(solver->formula->assignment, first) != VAR_TRUE) return false;
+    
+    size_t position = solver->trail_position[literal_variable(first)];
+    return solver->assignments->stack[position].reason == cref;
+}
+
+/**
+ * @brief Remove as cláusulas satisfeitas por atribuições do nível 0
+ * @param solver Instância do solver (no nível 0)
+ * @return true se alguma cláusula foi removida
+ * 
+ * Atribuições do nível 0 nunca são desfeitas, então essas cláusulas não
+ * voltam a importar. Razões de atribuições ainda na pilha são mantidas.
+ * A remoção libera espaço na arena, que é recuperado pela coleta quando
+ * o desperdício passa do limite configurado.
+ */
+bool remove_satisfied_clauses(dpll_solver_t *solver) {
+    if (!solver || solver->assignments->decision_level > 0) return false;
+    
+    cnf_formula_t *formula = solver->formula;
+    size_t kept = 0;
+    size_t removed = 0;
+    
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        clause_ref_t cref = formula->clauses.refs[i];
+        const clause_t *clause = cnf_clause(formula, cref);
+        
+        if (!clause->deleted && clause_is_satisfied(clause, formula->assignment) &&
+            !clause_is_locked(solver, cref)) {
+            /* Já contava como satisfeita: sai dos dois contadores */
+            if (solver->track_satisfaction && !clause->learnt) {
+                formula->satisfied_clauses--;
+                solver->original_clauses--;
+            }
+            cnf_delete_clause(formula, cref);
+            removed++;
+            continue;
+        }
+        formula->clauses.refs[kept++] = cref;
+    }
+    formula->clauses.count = kept;
+    solver->simplified_trail_size = solver->assignments->size;
+    
+    if (removed > 0 && solver->config.verbose) {
+        log_debug("Removidas %zu cláusulas satisfeitas no nível 0", removed);
+    }
+    
+    check_garbage(solver);
+    return removed > 0;
+}
+
+/* Coleta quando a fração desperdiçada da arena passa do limite configurado */
+static void check_garbage(dpll_solver_t *solver) {
+    const clause_arena_t *arena = &solver->formula->arena;
+    if (arena->wasted > arena->size * solver->config.garbage_fraction) {
+        collect_garbage(solver);
+    }
+}
+
+/**
+ * @brief Compacta a arena de cláusulas, descartando as removidas
+ * @param solver Instância do solver
+ * 
+ * Coleta por cópia: as cláusulas vivas vão para uma arena nova, dimensionada
+ * exatamente para elas, e todas as referências — lista da fórmula, listas de
+ * ocorrências, razões na pilha e listas de observação — são reescritas em uma
+ * única passada cada. Observadores de cláusulas removidas são descartados.
+ * Sem memória para a arena nova, a fórmula apenas continua fragmentada.
+ */
+void collect_garbage(dpll_solver_t *solver) {
+    if (!solver) return;
+    
+    cnf_formula_t *formula = solver->formula;
+    clause_arena_t *from = &formula->arena;
+    clause_arena_t to = {0};
+    if (!clause_arena_reserve(&to, from->size - from->wasted)) return;
+    
+    size_t before = from->size;
+    cnf_relocate_clauses(formula, &to);
+    
+    /* Razões na pilha de atribuições */
+    assignment_stack_t *trail = solver->assignments;
+    for (size_t i = 0; i < trail->size; i++) {
+        clause_ref_t reason = trail->stack[i].reason;
+        if (reason == CLAUSE_REF_UNDEF) continue;
+        trail->stack[i].reason = clause_arena_get(from, reason)->deleted
+                                     ? CLAUSE_REF_UNDEF
+                                     : clause_arena_relocate(from, &to, reason);
+    }
+    
+    /* Listas de observação */
+    size_t num_lists = 2 * ((size_t)formula->num_variables + 1);
+    for (size_t l = 0; l < num_lists; l++) {
+        watch_list_t *list = &solver->watches[l];
+        size_t kept = 0;
+        for (size_t k = 0; k < list->size; k++) {
+            clause_ref_t cref = list->watchers[k].clause;
+            if (clause_arena_get(from, cref)->deleted) continue;
+            list->watchers[kept] = list->watchers[k];
+            list->watchers[kept].clause = clause_arena_relocate(from, &to, cref);
+            kept++;
+        }
+        list->size = kept;
+    }
+    
+    clause_arena_dispose(from);
+    *from = to;
+    
+    if (solver->config.verbose) {
+        log_debug("Coleta da arena: %zu -> %zu palavras", before, from->size);
+    }
+}
+
 bool eliminate_pure_literals_preprocessing(dpll_solver_t *solver) {
     return pure_literal_elimination(solver);
 }
 
+/* ========== Sondagem de Literais ========== */
+
+/**
+ * @brief Fixa no nível 0 um literal implicado pela fórmula e propaga
+ * @return false se a fórmula se mostrou insatisfatível (conflito registrado)
+ */
+static bool probe_fix_literal(dpll_solver_t *solver, literal_t lit) {
+    var_assignment_t value = literal_value(solver->formula->assignment, lit);
+    if (value == VAR_FALSE) {
+        clause_ref_t empty = cnf_add_clause_literals(solver->formula, NULL, 0, false);
+        if (empty == CLAUSE_REF_UNDEF) {
+            log_error("Falha ao registrar cláusula vazia da sondagem");
+            exit(EXIT_FAILURE);
+        }
+        solver->conflict_clause = empty;
+        return false;
+    }
+    if (value == VAR_UNASSIGNED &&
+        !assign_variable(solver, literal_variable(lit),
+                         literal_is_positive(lit) ? VAR_TRUE : VAR_FALSE, false)) {
+        log_error("Falha ao empilhar literal da sondagem");
+        exit(EXIT_FAILURE);
+    }
+    return unit_propagation(solver) == CLAUSE_REF_UNDEF;
+}
+
+/**
+ * @brief Indica se a razão de uma implicação do nível 1 tem 2+ literais falsos nesse nível
+ *
+ * Só então o resolvente hiper-binário encurta um caminho do grafo de
+ * implicações; com um único literal falso no nível 1, a razão já age como
+ * binária.
+ */
+static bool reason_is_hyper(const dpll_solver_t *solver, const clause_t *reason) {
+    const assignment_stack_t *trail = solver->assignments;
+    size_t at_level = 0;
+    for (size_t k = 1; k < reason->size; k++) {
+        variable_t var = literal_variable(reason->literals[k]);
+        if (trail->stack[solver->trail_position[var]].decision_level > 0 && ++at_level == 2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Sondagem de literais falhos com resolução hiper-binária, no nível 0
+ * @param solver Instância do solver, no nível 0
+ * @param budget Ticks de propagação disponíveis (stats.ticks)
+ * @return false apenas em falha de alocação
+ *
+ * Cada variável candidata é atribuída no nível 1, nas duas polaridades:
+ * - se a polaridade l leva a conflito, ¬l vale no nível 0 (literal falho);
+ * - os literais implicados pelas duas polaridades valem no nível 0;
+ * - um literal y implicado por uma razão com dois ou mais literais falsos
+ *   no nível 1 gera o resolvente hiper-binário (¬l ∨ y), guardado como
+ *   aprendida da camada core.
+ * As candidatas são as variáveis com cláusulas binárias, começando pelas
+ * raízes do grafo de implicações binárias (literais que implicam outros e
+ * não são implicados por nenhum), de onde partem as cadeias mais longas.
+ * Uma insatisfatibilidade fica registrada em solver->conflict_clause.
+ */
+bool probe_literals(dpll_solver_t *solver, uint64_t budget) {
+    if (!solver || solver->assignments->decision_level > 0) return true;
+    if (unit_propagation(solver) != CLAUSE_REF_UNDEF) return true;
+    
+    cnf_formula_t *formula = solver->formula;
+    const assignment_stack_t *trail = solver->assignments;
+    variable_t num_variables = formula->num_variables;
+    size_t num_literals = 2 * ((size_t)num_variables + 1);
+    
+    /* Cláusulas binárias não satisfeitas de cada literal */
+    uint32_t *binary = safe_calloc(num_literals, sizeof(uint32_t));
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        const clause_t *clause = cnf_clause(formula, formula->clauses.refs[i]);
+        if (clause->deleted || clause->size != 2) continue;
+        if (clause_is_satisfied(clause, formula->assignment)) continue;
+        binary[literal_index(clause->literals[0])]++;
+        binary[literal_index(clause->literals[1])]++;
+    }
+    
+    /* Raízes primeiro: uma polaridade só aparece negada nas binárias */
+    variable_t *order = safe_malloc(((size_t)num_variables + 1) * sizeof(variable_t));
+    size_t num_candidates = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        for (variable_t var = 1; var <= num_variables; var++) {
+            if (IS_VARIABLE_ASSIGNED(solver, var) || IS_VARIABLE_ELIMINATED(solver, var)) continue;
+            uint32_t positive = binary[literal_index(var)];
+            uint32_t negative = binary[literal_index(-var)];
+            if (positive + negative == 0) continue;
+            bool root = positive == 0 || negative == 0;
+            if (root == (pass == 0)) {
+                order[num_candidates++] = var;
+            }
+        }
+    }
+    
+    uint32_t *implied = safe_calloc(num_literals, sizeof(uint32_t));
+    literal_vector_t common = {0};
+    literal_vector_t hyper = {0};
+    bool ok = true;
+    bool consistent = true;
+    uint64_t limit = solver->stats.ticks + budget;
+    
+    for (size_t c = 0; c < num_candidates && consistent && solver->stats.ticks < limit; c++) {
+        variable_t var = order[c];
+        if (IS_VARIABLE_ASSIGNED(solver, var)) continue;
+        
+        /* A raiz (sem binárias que a impliquem) é sondada primeiro */
+        literal_t first = binary[literal_index(var)] == 0 ? var : -var;
+        literal_t probes[2] = { first, -first };
+        uint32_t stamp = (uint32_t)c + 1;
+        bool failed = false;
+        common.size = 0;
+        
+        for (int p = 0; p < 2 && !failed; p++) {
+            literal_t lit = probes[p];
+            size_t start = trail->size;
+            if (!push_assignment(solver, var, literal_is_positive(lit) ? VAR_TRUE : VAR_FALSE,
+                                 true, CLAUSE_REF_UNDEF)) {
+                log_error("Falha ao empilhar literal sondado");
+                exit(EXIT_FAILURE);
+            }
+            
+            if (propagate(solver) != CLAUSE_REF_UNDEF) {
+                backjump(solver, 0);
+                solver->stats.failed_literals++;
+                failed = true;
+                consistent = probe_fix_literal(solver, -lit);
+                continue;
+            }
+            
+            hyper.size = 0;
+            for (size_t i = start + 1; i < trail->size && ok; i++) {
+                const assignment_entry_t *entry = &trail->stack[i];
+                literal_t lit_implied = entry->value == VAR_TRUE ? entry->variable : -entry->variable;
+                if (p == 0) {
+                    implied[literal_index(lit_implied)] = stamp;
+                } else if (implied[literal_index(lit_implied)] == stamp) {
+                    ok = literal_vector_push(&common, lit_implied);
+                }
+                if (ok && entry->reason != CLAUSE_REF_UNDEF &&
+                    cnf_clause(formula, entry->reason)->size > 2 &&
+                    reason_is_hyper(solver, cnf_clause(formula, entry->reason))) {
+                    ok = literal_vector_push(&hyper, lit_implied);
+                }
+            }
+            backjump(solver, 0);
+            
+            /* Resolventes (y ∨ ¬l), observados já no nível 0 */
+            for (size_t k = 0; k < hyper.size && ok; k++) {
+                literal_t literals[2] = { hyper.literals[k], -lit };
+                clause_ref_t cref = cnf_add_clause_literals(formula, literals, 2, true);
+                if (cref == CLAUSE_REF_UNDEF) {
+                    ok = false;
+                    break;
+                }
+                clause_t *clause = cnf_clause(formula, cref);
+                clause->lbd = 2;
+                clause->tier = CLAUSE_TIER_CORE;
+                clause->activity = (float)solver->clause_activity_increment;
+                ok = attach_clause(solver, cref);
+                solver->stats.hyper_binary++;
+            }
+            solver->stats.ticks += hyper.size;
+            if (!ok) break;
+        }
+        if (!ok) break;
+        
+        for (size_t k = 0; k < common.size && !failed && consistent; k++) {
+            solver->stats.implied_literals++;
+            consistent = probe_fix_literal(solver, common.literals[k]);
+        }
+    }
+    
+    free(binary);
+    free(order);
+    free(implied);
+    literal_vector_dispose(&common);
+    literal_vector_dispose(&hyper);
+    
+    if (solver->config.verbose) {
+        log_debug("Sondagem: %llu literais falhos, %llu implicados, %llu hiper-binárias",
+                  (unsigned long long)solver->stats.failed_literals,
+                  (unsigned long long)solver->stats.implied_literals,
+                  (unsigned long long)solver->stats.hyper_binary);
+    }
+    return ok;
+}
+
+/* ========== Vivificação ========== */
+
+/* Retira de uma lista de observação o observador da cláusula */
+static void detach_watch(watch_list_t *list, clause_ref_t cref) {
+    for (size_t k = 0; k < list->size; k++) {
+        if (list->watchers[k].clause == cref) {
+            list->watchers[k] = list->watchers[--list->size];
+            return;
+        }
+    }
+}
+
+/* Indica se a cláusula é a razão de algum de seus literais na pilha atual */
+static bool clause_is_reason(const dpll_solver_t *solver, clause_ref_t cref,
+                             const literal_t *literals, size_t size) {
+    const assignment_stack_t *trail = solver->assignments;
+    for (size_t k = 0; k < size; k++) {
+        if (literal_value(solver->formula->assignment, literals[k]) == VAR_TRUE &&
+            trail->stack[solver->trail_position[literal_variable(literals[k])]].reason == cref) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Tenta encurtar uma cláusula C = (l1 ∨ ... ∨ lk), a partir do nível 0
+ * @param solver Instância do solver, no nível 0
+ * @param cref Cláusula, com 3+ literais e não satisfeita no nível 0
+ *
+ * Decide ¬l1, ¬l2, ... (um nível por literal) e propaga após cada um:
+ * - li já falso: implicado pelos anteriores, sai de C;
+ * - li já verdadeiro, ou conflito após decidir ¬li: os literais decididos
+ *   até ali (com li) já formam uma cláusula implicada, e o resto sai.
+ * Se C participa da propagação (vira razão ou conflito), a prova usaria a
+ * própria C e nada muda. A cláusula encurtada é reescrita no lugar e volta
+ * a ser observada; se sobra um literal, ele vale no nível 0.
+ */
+static void vivify_clause(dpll_solver_t *solver, clause_ref_t cref) {
+    cnf_formula_t *formula = solver->formula;
+    const clause_t *clause = cnf_clause(formula, cref);
+    size_t size = clause->size;
+    literal_t *literals = solver->learnt_buffer;
+    memcpy(literals, clause->literals, size * sizeof(literal_t));
+    
+    size_t kept = 0;
+    bool aborted = false;
+    for (size_t k = 0; k < size; k++) {
+        literal_t lit = literals[k];
+        var_assignment_t value = literal_value(formula->assignment, lit);
+        if (value == VAR_FALSE) continue;
+        
+        literals[kept++] = lit;
+        if (value == VAR_TRUE || k + 1 == size) break;
+        
+        if (!push_assignment(solver, literal_variable(lit),
+                             literal_is_positive(lit) ? VAR_FALSE : VAR_TRUE, true,
+                             CLAUSE_REF_UNDEF)) {
+            log_error("Falha ao empilhar decisão da vivificação");
+            exit(EXIT_FAILURE);
+        }
+        clause_ref_t conflict = propagate(solver);
+        if (conflict == cref || clause_is_reason(solver, cref, literals + kept, size - kept)) {
+            aborted = true;
+            break;
+        }
+        if (conflict != CLAUSE_REF_UNDEF) break;
+    }
+    backjump(solver, 0);
+    if (aborted || kept == size) return;
+    
+    solver->stats.vivified_clauses++;
+    solver->stats.vivified_literals += size - kept;
+    
+    if (kept == 1) {
+        /* C fica satisfeita e sai na próxima remoção de satisfeitas */
+        if (!assign_variable(solver, literal_variable(literals[0]),
+                             literal_is_positive(literals[0]) ? VAR_TRUE : VAR_FALSE, false)) {
+            log_error("Falha ao empilhar unitária da vivificação");
+            exit(EXIT_FAILURE);
+        }
+        unit_propagation(solver);
+        return;
+    }
+    
+    clause_t *shortened = cnf_clause(formula, cref);
+    detach_watch(&solver->watches[literal_index(shortened->literals[0])], cref);
+    detach_watch(&solver->watches[literal_index(shortened->literals[1])], cref);
+    memcpy(shortened->literals, literals, kept * sizeof(literal_t));
+    clause_arena_shrink(&formula->arena, cref, kept);
+    if (shortened->learnt && shortened->lbd > kept) {
+        shortened->lbd = (uint32_t)kept;
+    }
+    if (!attach_clause(solver, cref)) {
+        log_error("Falha ao observar cláusula vivificada");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Vivificação das cláusulas, no nível 0
+ * @param solver Instância do solver, no nível 0 e com a propagação completa
+ * @param budget Ticks de propagação disponíveis (stats.ticks)
+ * 
+ * Um cursor circular sobre a lista de cláusulas faz cada chamada continuar
+ * de onde a anterior parou. Ficam de fora binárias, aprendidas da camada
+ * local (logo descartadas) e, quando o solver mantém contadores de
+ * satisfação, as originais, cujas listas de ocorrências ficariam
+ * desatualizadas. Uma insatisfatibilidade fica registrada em
+ * solver->conflict_clause.
+ */
+void vivify_clauses(dpll_solver_t *solver, uint64_t budget) {
+    if (!solver || solver->assignments->decision_level > 0) return;
+    if (unit_propagation(solver) != CLAUSE_REF_UNDEF) return;
+    
+    cnf_formula_t *formula = solver->formula;
+    uint64_t limit = solver->stats.ticks + budget;
+    size_t count = formula->clauses.count;
+    
+    for (size_t n = 0; n < count && solver->stats.ticks < limit; n++) {
+        if (solver->vivify_position >= count) {
+            solver->vivify_position = 0;
+        }
+        clause_ref_t cref = formula->clauses.refs[solver->vivify_position++];
+        const clause_t *clause = cnf_clause(formula, cref);
+        if (clause->deleted || clause->size < 3) continue;
+        if (clause->learnt ? clause->tier == CLAUSE_TIER_LOCAL : solver->track_satisfaction) continue;
+        if (clause_is_satisfied(clause, formula->assignment)) continue;
+        
+        vivify_clause(solver, cref);
+        if (solver->conflict_clause != CLAUSE_REF_UNDEF) break;
+    }
+    
+    if (solver->config.verbose) {
+        log_debug("Vivificação: %llu cláusulas encurtadas, %llu literais removidos",
+                  (unsigned long long)solver->stats.vivified_clauses,
+                  (unsigned long long)solver->stats.vivified_literals);
+    }
+}
+
+/* ========== Inprocessamento ========== */
+
+/* Orçamento mínimo de cada execução, em ticks */
+#define INPROCESS_MIN_TICKS 10000ULL
+
+static inprocess_schedule_t schedule_start(uint64_t interval) {
+    inprocess_schedule_t schedule = { interval, interval, 0 };
+    return schedule;
+}
+
+static bool schedule_due(const dpll_solver_t *solver, const inprocess_schedule_t *schedule) {
+    return solver->stats.conflicts >= schedule->next;
+}
+
+/* Orçamento da execução: fração dos ticks gastos desde a execução anterior */
+static uint64_t schedule_budget(const dpll_solver_t *solver, const inprocess_schedule_t *schedule,
+                                double effort) {
+    return INPROCESS_MIN_TICKS + (uint64_t)(effort * (double)(solver->stats.ticks - schedule->ticks));
+}
+
+/* Registra a execução e alonga o intervalo até a próxima */
+static void schedule_advance(dpll_solver_t *solver, inprocess_schedule_t *schedule) {
+    schedule->ticks = solver->stats.ticks;
+    schedule->interval = (uint64_t)((double)schedule->interval * solver->config.inprocess_growth);
+    schedule->next = solver->stats.conflicts + schedule->interval;
+}
+
+/* Eliminação: equivalências, bloqueadas e BVE compartilham a agenda */
+static bool elimination_enabled(const solver_config_t *config) {
+    return config->enable_elimination || config->enable_blocked || config->enable_equivalences;
+}
+
+static bool inprocessing_due(const dpll_solver_t *solver) {
+    const solver_config_t *config = &solver->config;
+    if (!config->enable_inprocessing) return false;
+    
+    return (config->enable_probing && schedule_due(solver, &solver->probe_schedule)) ||
+           (config->enable_vivification && schedule_due(solver, &solver->vivify_schedule)) ||
+           (config->enable_subsumption && schedule_due(solver, &solver->subsume_schedule)) ||
+           (elimination_enabled(config) && schedule_due(solver, &solver->elim_schedule));
+}
+
+/**
+ * @brief Uma rodada de inprocessamento, no nível 0
+ * @param solver Instância do solver, no nível 0
+ * @return false apenas em falha de alocação
+ * 
+ * Cada técnica tem sua agenda: roda quando os conflitos atingem o prazo, e
+ * o intervalo seguinte é inprocess_growth vezes o anterior. O orçamento é
+ * a fração configurada dos ticks de propagação gastos desde a execução
+ * anterior da técnica, de modo que o esforço total acompanha a busca.
+ * Sondagem e vivificação contam ticks; subsunção e eliminação, literais
+ * visitados nas listas de ocorrências, tratados na mesma unidade. A ordem
+ * vai da técnica mais barata à mais cara: unitárias da sondagem e
+ * cláusulas encurtadas pela vivificação reduzem a fórmula que a
+ * simplificação percorre. Uma insatisfatibilidade fica registrada em
+ * solver->conflict_clause.
+ */
+bool inprocess_formula(dpll_solver_t *solver) {
+    if (!solver || solver->assignments->decision_level > 0) return true;
+    
+    const solver_config_t *config = &solver->config;
+    SOLVER_STATS_INCREMENT(solver, inprocessings);
+    
+    if (config->enable_probing && schedule_due(solver, &solver->probe_schedule)) {
+        if (!probe_literals(solver, schedule_budget(solver, &solver->probe_schedule,
+                                                    config->probe_effort))) {
+            return false;
+        }
+        schedule_advance(solver, &solver->probe_schedule);
+    }
+    
+    if (config->enable_vivification && schedule_due(solver, &solver->vivify_schedule) &&
+        !has_conflict(solver)) {
+        vivify_clauses(solver, schedule_budget(solver, &solver->vivify_schedule,
+                                               config->vivify_effort));
+        schedule_advance(solver, &solver->vivify_schedule);
+    }
+    
+    /* Subsunção e eliminação vencidas juntas remontam as ocorrências uma só vez */
+    bool subsume = config->enable_subsumption && schedule_due(solver, &solver->subsume_schedule);
+    bool eliminate = elimination_enabled(config) && schedule_due(solver, &solver->elim_schedule);
+    if ((subsume || eliminate) && unit_propagation(solver) == CLAUSE_REF_UNDEF) {
+        uint64_t subsume_budget = subsume ? schedule_budget(solver, &solver->subsume_schedule,
+                                                            config->subsume_effort) : 0;
+        uint64_t elim_budget = eliminate ? schedule_budget(solver, &solver->elim_schedule,
+                                                           config->elim_effort) : 0;
+        if (!simplify_clauses(solver, subsume_budget, elim_budget)) {
+            return false;
+        }
+        if (subsume) schedule_advance(solver, &solver->subsume_schedule);
+        if (eliminate) schedule_advance(solver, &solver->elim_schedule);
+    }
+    
+    if (config->verbose) {
+        log_debug("Inprocessamento %llu após %llu conflitos",
+                  (unsigned long long)solver->stats.inprocessings,
+                  (unsigned long long)solver->stats.conflicts);
+    }
+    return true;
+}
+
 /* ========== Reinicializações ========== */
 
+/* Conflitos mínimos desde o último restart antes de o glucose comparar as médias */
+#define GLUCOSE_MIN_CONFLICTS 50
+/* Conflitos totais antes de o glucose começar a bloquear restarts */
+#define GLUCOSE_BLOCK_MIN_CONFLICTS 10000
+
+/**
+ * @brief Termo i (a partir de 0) da sequência de Luby: 1 1 2 1 1 2 4 1 1 2 ...
+ */
+static size_t luby(size_t index) {
+    size_t size = 1;
+    size_t seq = 0;
+    
+    /* Menor subsequência completa (2^k - 1 termos) que contém o índice */
+    while (size < index + 1) {
+        seq++;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != index) {
+        size = (size - 1) >> 1;
+        seq--;
+        index %= size;
+    }
+    
+    return (size_t)1 << seq;
+}
+
+/* Média móvel exponencial; nas primeiras amostras usa a média simples */
+static void ema_update(double *ema, double value, double alpha, uint64_t samples) {
+    double weight = samples > 0 && 1.0 / (double)samples > alpha ? 1.0 / (double)samples : alpha;
+    *ema += weight * (value - *ema);
+}
+
+/**
+ * @brief Atualiza o estado da política de reinicialização a cada conflito
+ * @param solver Instância do solver (com o conflito ainda na pilha)
+ * @param lbd LBD da cláusula aprendida (ou da cláusula em conflito no DPLL)
+ * 
+ * Só a política glucose usa esse estado: médias móveis rápida e lenta do
+ * LBD e média do tamanho da pilha. Uma pilha bem acima da média indica que
+ * a busca pode estar perto de um modelo, e o restart é adiado (bloqueio).
+ */
+void restart_on_conflict(dpll_solver_t *solver, uint32_t lbd) {
+    if (!solver || solver->config.restart_policy != RESTART_GLUCOSE) return;
+    
+    uint64_t conflicts = solver->stats.conflicts;
+    double trail_size = (double)solver->assignments->size;
+    
+    if (conflicts > GLUCOSE_BLOCK_MIN_CONFLICTS &&
+        solver->conflicts_since_restart >= GLUCOSE_MIN_CONFLICTS &&
+        trail_size > solver->config.glucose_block_margin * solver->trail_ema) {
+        solver->conflicts_since_restart = 0;
+    }
+    
+    ema_update(&solver->trail_ema, trail_size, 1.0 / 5000.0, conflicts);
+    ema_update(&solver->lbd_ema_fast, lbd, 1.0 / 32.0, conflicts);
+    ema_update(&solver->lbd_ema_slow, lbd, 1.0 / 10000.0, conflicts);
+}
+
+/**
+ * @brief Indica se a busca deve reiniciar, segundo a política configurada
+ * 
+ * - fixa: a cada restart_threshold conflitos;
+ * - Luby e geométrica: quando os conflitos desde o último restart atingem
+ *   restart_limit, recalculado por perform_restart();
+ * - glucose: quando o LBD recente (média rápida) supera a média de longo
+ *   prazo por glucose_margin, ou seja, as cláusulas aprendidas pioraram.
+ */
 bool should_restart(const dpll_solver_t *solver) {
     if (!solver) return false;
     
-    return solver->conflicts_since_restart >= solver->config.restart_threshold;
+    switch (solver->config.restart_policy) {
+        case RESTART_LUBY:
+        case RESTART_GEOMETRIC:
+            return solver->conflicts_since_restart >= solver->restart_limit;
+        case RESTART_GLUCOSE:
+            return solver->conflicts_since_restart >= GLUCOSE_MIN_CONFLICTS &&
+                   solver->lbd_ema_fast > solver->config.glucose_margin * solver->lbd_ema_slow;
+        case RESTART_FIXED:
+        default:
+            return solver->conflicts_since_restart >= solver->config.restart_threshold;
+    }
 }
 
+/**
+ * @brief Volta ao nível 0 e prepara o próximo intervalo
+ * 
+ * Desfaz apenas as entradas da pilha acima do nível 0 (backjump); o resto
+ * do array de atribuições não é tocado.
+ */
 void perform_restart(dpll_solver_t *solver) {
     if (!solver) return;
     
-    /* Desfazer todas as decisões, mantendo apenas as propagações de nível 0 */
-    unassign_until_level(solver, 0);
+    backjump(solver, 0);
+    solver->conflicts_since_restart = 0;
     
     SOLVER_STATS_INCREMENT(solver, restarts);
+    if (solver->config.restart_policy == RESTART_LUBY) {
+        solver->restart_limit = solver->config.luby_unit * luby(solver->stats.restarts);
+    } else if (solver->config.restart_policy == RESTART_GEOMETRIC) {
+        solver->restart_limit = (size_t)(solver->restart_limit * solver->config.restart_factor);
+    }
     
     if (solver->config.verbose) {
         log_debug("Reinicialização executada");
@@ -796,18 +2311,8 @@ void perform_restart(dpll_solver_t *solver) {
 void unassign_until_level(dpll_solver_t *solver, size_t level) {
     if (!solver) return;
     
-    assignment_stack_backtrack_to_level(solver->assignments, level);
-    
-    /* Limpar atribuições na fórmula */
-    for (variable_t var = 1; var <= solver->formula->num_variables; var++) {
-        solver->formula->assignment[var] = VAR_UNASSIGNED;
-    }
-    
-    /* Reaplicar atribuições restantes */
-    for (size_t i = 0; i < solver->assignments->size; i++) {
-        assignment_entry_t *entry = &solver->assignments->stack[i];
-        solver->formula->assignment[entry->variable] = entry->value;
-    }
+    /* Desfazer pela pilha mantém os contadores incrementais consistentes */
+    backjump(solver, level);
 }
 
 /* ========== Informações e Utilidades ========== */
@@ -851,12 +2356,24 @@ void solver_print_assignment(const dpll_solver_t *solver) {
 bool validate_solution(const dpll_solver_t *solver) {
     if (!solver) return false;
     
-    return cnf_validate_assignment(solver->formula);
+    /* Só as originais: aprendidas após uma eliminação no inprocessamento derivam da
+       fórmula reduzida e podem ser falsas no modelo estendido */
+    const cnf_formula_t *formula = solver->formula;
+    for (size_t i = 0; i < formula->clauses.count; i++) {
+        const clause_t *clause = cnf_clause(formula, formula->clauses.refs[i]);
+        if (clause->learnt || clause->deleted) continue;
+        if (!clause_is_satisfied(clause, formula->assignment)) {
+            printf("Cláusula %zu não satisfeita!\n", i + 1);
+            return false;
+        }
+    }
+    
+    return true;
 }
 
 bool validate_partial_assignment(const dpll_solver_t *solver) {
     if (!solver) return false;
     
-    /* Verificar se não há conflitos nas cláusulas */
-    return !has_conflict(solver);
+    /* Verificar se não há conflitos nas cláusulas (varredura completa) */
+    return !cnf_has_conflict(solver->formula);
 }
\ No newline at end of file
@@ -5,7 +5,7 @@
  * @date 2025
  * 
  * Este arquivo implementa as estruturas fundamentais do SAT solver:
- * - Cláusulas (conjuntos de literais)
+ * - Cláusulas (conjuntos de literais) em uma arena contígua
  * - Fórmulas CNF (conjuntos de cláusulas)
  * - Pilha de atribuições para backtracking
  * - Operações de avaliação e manipulação
@@ -19,81 +19,6 @@
 
 /* ========== Funções para Cláusulas ========== */
 
-/**
- * @brief Cria uma nova cláusula com capacidade inicial especificada
- * @param initial_capacity Capacidade inicial do array de literais
- * @return Ponteiro para a cláusula criada ou NULL em caso de erro
- * 
- * Aloca memória para uma cláusula vazia que pode crescer dinamicamente.
- * Capacidade mínima é 4 literais para evitar realocações frequentes.
- */
-clause_t* clause_create(size_t initial_capacity) {
-    clause_t *clause = malloc(sizeof(clause_t));
-    if (!clause) return NULL;
-    
-    clause->capacity = initial_capacity > 0 ? initial_capacity : 4;
-    clause->literals = malloc(clause->capacity * sizeof(literal_t));
-    if (!clause->literals) {
-        free(clause);
-        return NULL;
-    }
-    
-    clause->size = 0;                    ///< Inicialmente vazia
-    clause->is_satisfied = false;        ///< Estado não satisfeita
-    clause->is_unit = false;
-    clause->unit_literal = 0;
-    
-    return clause;
-}
-
-void clause_destroy(clause_t *clause) {
-    if (clause) {
-        free(clause->literals);
-        free(clause);
-    }
-}
-
-bool clause_add_literal(clause_t *clause, literal_t literal) {
-    if (!clause || literal == 0) return false;
-    
-    /* Evitar duplicatas exatas, mas permitir polaridades opostas para detectar tautologia depois */
-    for (size_t i = 0; i < clause->size; i++) {
-        if (clause->literals[i] == literal) {
-            return true; /* Literal já existe, não é erro */
-        }
-    }
-    
-    /* Expandir array se necessário */
-    if (clause->size >= clause->capacity) {
-        size_t new_capacity = clause->capacity * 2;
-        literal_t *new_literals = realloc(clause->literals, new_capacity * sizeof(literal_t));
-        if (!new_literals) return false;
-        
-        clause->literals = new_literals;
-        clause->capacity = new_capacity;
-    }
-    
-    clause->literals[clause->size++] = literal;
-    return true;
-}
-
-bool clause_is_tautology(const clause_t *clause) {
-    if (!clause) return false;
-    for (size_t i = 0; i < clause->size; ++i) {
-        variable_t vi = literal_variable(clause->literals[i]);
-        bool pi = literal_is_positive(clause->literals[i]);
-        for (size_t j = i + 1; j < clause->size; ++j) {
-            if (vi == literal_variable(clause->literals[j])) {
-                bool pj = literal_is_positive(clause->literals[j]);
-                if (pi != pj) {
-                    return true; /* contém v e ¬v */
-                }
-            }
-        }
-    }
-    return false;
-}
-
 bool clause_is_satisfied(const clause_t *clause, const var_assignment_t *assignment) {
     if (!clause || !assignment) return false;
     
@@ -171,93 +96,455 @@ bool clause_is_conflicting(const clause_t *clause, const var_assignment_t *assig
     return true; /* Todos os literais estão falsificados */
 }
 
-clause_t* clause_copy(const clause_t *clause) {
-    if (!clause) return NULL;
+/* ========== Funções para Vetores de Literais ========== */
+
+bool literal_vector_push(literal_vector_t *vector, literal_t literal) {
+    if (!vector) return false;
     
-    clause_t *copy = clause_create(clause->capacity);
-    if (!copy) return NULL;
+    /* Expandir array se necessário */
+    if (vector->size >= vector->capacity) {
+        size_t new_capacity = vector->capacity > 0 ? vector->capacity * 2 : 8;
+        literal_t *new_literals = realloc(vector->literals, new_capacity * sizeof(literal_t));
+        if (!new_literals) return false;
+        
+        vector->literals = new_literals;
+        vector->capacity = new_capacity;
+    }
     
-    copy->size = clause->size;
-    memcpy(copy->literals, clause->literals, clause->size * sizeof(literal_t));
-    copy->is_satisfied = clause->is_satisfied;
-    copy->is_unit = clause->is_unit;
-    copy->unit_literal = clause->unit_literal;
+    vector->literals[vector->size++] = literal;
+    return true;
+}
+
+bool literal_vector_contains(const literal_vector_t *vector, literal_t literal) {
+    if (!vector) return false;
+    for (size_t i = 0; i < vector->size; i++) {
+        if (vector->literals[i] == literal) return true;
+    }
+    return false;
+}
+
+void literal_vector_dispose(literal_vector_t *vector) {
+    if (!vector) return;
+    free(vector->literals);
+    vector->literals = NULL;
+    vector->size = 0;
+    vector->capacity = 0;
+}
+
+/* ========== Normalização de Cláusulas ========== */
+
+bool clause_normalizer_init(clause_normalizer_t *normalizer, variable_t num_variables,
+                            bool sort_literals) {
+    if (!normalizer || num_variables <= 0) return false;
     
-    return copy;
+    normalizer->marks = calloc(2 * ((size_t)num_variables + 1), sizeof(uint32_t));
+    if (!normalizer->marks) return false;
+    normalizer->stamp = 0;
+    normalizer->num_variables = num_variables;
+    normalizer->sort_literals = sort_literals;
+    return true;
+}
+
+void clause_normalizer_dispose(clause_normalizer_t *normalizer) {
+    if (!normalizer) return;
+    free(normalizer->marks);
+    normalizer->marks = NULL;
+    normalizer->stamp = 0;
+    normalizer->num_variables = 0;
 }
 
-/* ========== Funções para Lista de Cláusulas ========== */
+static int compare_literals(const void *a, const void *b) {
+    literal_t x = *(const literal_t*)a;
+    literal_t y = *(const literal_t*)b;
+    variable_t vx = literal_variable(x);
+    variable_t vy = literal_variable(y);
+    if (vx != vy) return vx < vy ? -1 : 1;
+    return (x > y) - (x < y);
+}
 
-clause_list_t* clause_list_create(size_t initial_capacity) {
-    clause_list_t *list = malloc(sizeof(clause_list_t));
-    if (!list) return NULL;
+/**
+ * @brief Remove literais repetidos e detecta tautologias em O(k)
+ * @param normalizer Normalizador com marcas para todas as variáveis
+ * @param literals Literais da cláusula (dentro de [1, num_variables]), alterados no lugar
+ * @param size Entrada: número de literais; saída: número sem duplicatas
+ * @return false se a cláusula contém x e ¬x (tautologia)
+ * 
+ * Um literal repetido encontra a própria marca com o carimbo corrente;
+ * o oposto de um literal já visto indica tautologia. Com sort_literals,
+ * a cláusula resultante fica ordenada por variável.
+ */
+bool clause_normalize(clause_normalizer_t *normalizer, literal_t *literals, size_t *size) {
+    if (!normalizer || !normalizer->marks || !size) return false;
     
-    list->capacity = initial_capacity > 0 ? initial_capacity : 8;
-    list->clauses = malloc(list->capacity * sizeof(clause_t));
-    if (!list->clauses) {
-        free(list);
-        return NULL;
+    /* Novo carimbo; ao dar a volta no contador, as marcas antigas são zeradas */
+    if (++normalizer->stamp == 0) {
+        memset(normalizer->marks, 0,
+               2 * ((size_t)normalizer->num_variables + 1) * sizeof(uint32_t));
+        normalizer->stamp = 1;
     }
+    uint32_t stamp = normalizer->stamp;
+    uint32_t *marks = normalizer->marks;
     
-    list->count = 0;
-    return list;
+    size_t kept = 0;
+    for (size_t i = 0; i < *size; i++) {
+        literal_t lit = literals[i];
+        size_t index = 2 * (size_t)literal_variable(lit) + (lit < 0);
+        if (marks[index] == stamp) continue;          /* duplicata */
+        if (marks[index ^ 1] == stamp) return false;  /* contém v e ¬v */
+        marks[index] = stamp;
+        literals[kept++] = lit;
+    }
+    *size = kept;
+    
+    if (normalizer->sort_literals && kept > 1) {
+        qsort(literals, kept, sizeof(literal_t), compare_literals);
+    }
+    return true;
 }
 
-void clause_list_destroy(clause_list_t *list) {
-    if (list) {
-        for (size_t i = 0; i < list->count; i++) {
-            /* As cláusulas são armazenadas por valor; apenas liberar seus arrays internos */
-            free(list->clauses[i].literals);
-            list->clauses[i].literals = NULL;
-            list->clauses[i].size = 0;
-            list->clauses[i].capacity = 0;
-        }
-        free(list->clauses);
-        free(list);
+/**
+ * @brief Indica se uma cláusula já está livre de duplicatas e tautologias
+ * @param normalizer Normalizador com marcas para todas as variáveis
+ * @param literals Literais da cláusula (dentro de [1, num_variables]), não alterados
+ * @param size Número de literais
+ * @return true se clause_normalize não removeria nem rejeitaria nada
+ *
+ * Permite usar a cláusula no lugar (sem cópia) no caso comum; a ordem dos
+ * literais não é verificada.
+ */
+bool clause_is_normalized(clause_normalizer_t *normalizer, const literal_t *literals, size_t size) {
+    if (!normalizer || !normalizer->marks) return false;
+    
+    if (++normalizer->stamp == 0) {
+        memset(normalizer->marks, 0,
+               2 * ((size_t)normalizer->num_variables + 1) * sizeof(uint32_t));
+        normalizer->stamp = 1;
+    }
+    uint32_t stamp = normalizer->stamp;
+    uint32_t *marks = normalizer->marks;
+    
+    for (size_t i = 0; i < size; i++) {
+        size_t index = 2 * (size_t)literal_variable(literals[i]) + (literals[i] < 0);
+        if (marks[index] == stamp || marks[index ^ 1] == stamp) return false;
+        marks[index] = stamp;
+    }
+    return true;
+}
+
+/* ========== Funções para a Arena de Cláusulas ========== */
+
+/* Palavras ocupadas por uma cláusula; mesmo vazia, reserva literals[0] para a coleta */
+static size_t clause_arena_words(size_t size) {
+    return CLAUSE_HEADER_WORDS + (size > 0 ? size : 1);
+}
+
+/**
+ * @brief Garante espaço para mais palavras sem realocar
+ * @param arena Arena de cláusulas
+ * @param words Palavras que serão alocadas em seguida
+ * @return false se excede o limite das referências de 32 bits ou falta memória
+ */
+bool clause_arena_reserve(clause_arena_t *arena, size_t words) {
+    if (!arena) return false;
+    if (arena->size + words >= CLAUSE_REF_UNDEF) return false;
+    if (arena->size + words <= arena->capacity) return true;
+    
+    size_t new_capacity = arena->capacity > 0 ? arena->capacity : 1024;
+    while (new_capacity < arena->size + words) {
+        new_capacity *= 2;
+    }
+    if (new_capacity > CLAUSE_REF_UNDEF) new_capacity = CLAUSE_REF_UNDEF;
+    
+    uint32_t *new_memory = realloc(arena->memory, new_capacity * sizeof(uint32_t));
+    if (!new_memory) return false;
+    
+    arena->memory = new_memory;
+    arena->capacity = new_capacity;
+    return true;
+}
+
+/**
+ * @brief Copia uma cláusula para o fim da arena
+ * @param arena Arena de cláusulas
+ * @param literals Literais da cláusula
+ * @param size Número de literais
+ * @param learnt Se a cláusula é aprendida
+ * @return Referência da cláusula ou CLAUSE_REF_UNDEF em falha de alocação
+ * 
+ * Cabeçalho e literais ocupam palavras consecutivas, então percorrer uma
+ * cláusula é um acesso sequencial. A arena cresce por duplicação; como o
+ * bloco pode mudar de endereço, ponteiros obtidos com clause_arena_get()
+ * não sobrevivem a uma nova alocação — apenas as referências.
+ */
+clause_ref_t clause_arena_alloc(clause_arena_t *arena, const literal_t *literals, size_t size,
+                                bool learnt) {
+    if (!arena || (size > 0 && !literals)) return CLAUSE_REF_UNDEF;
+    
+    size_t words = clause_arena_words(size);
+    if (!clause_arena_reserve(arena, words)) return CLAUSE_REF_UNDEF;
+    
+    clause_ref_t ref = (clause_ref_t)arena->size;
+    clause_t *clause = clause_arena_get(arena, ref);
+    clause->size = (uint32_t)size;
+    clause->learnt = learnt;
+    clause->deleted = false;
+    clause->relocated = false;
+    clause->used = false;
+    clause->tier = CLAUSE_TIER_LOCAL;
+    clause->lbd = 0;
+    clause->true_literals = 0;
+    clause->activity = 0.0f;
+    if (size > 0) {
+        memcpy(clause->literals, literals, size * sizeof(literal_t));
+    }
+    arena->size += words;
+    
+    return ref;
+}
+
+/**
+ * @brief Marca uma cláusula como removida e contabiliza o espaço desperdiçado
+ * 
+ * A memória só é recuperada por uma coleta (clause_arena_relocate() das
+ * cláusulas vivas para uma arena nova); até lá, quem guarda referências
+ * deve ignorar cláusulas com a marca deleted.
+ */
+void clause_arena_free(clause_arena_t *arena, clause_ref_t ref) {
+    if (!arena) return;
+    clause_t *clause = clause_arena_get(arena, ref);
+    if (clause->deleted) return;
+    clause->deleted = true;
+    arena->wasted += clause_arena_words(clause->size);
+}
+
+/**
+ * @brief Reduz uma cláusula no lugar, mantendo os primeiros size literais
+ *
+ * As palavras liberadas no fim da cláusula contam como desperdício e
+ * voltam na próxima coleta, que copia apenas o tamanho novo.
+ */
+void clause_arena_shrink(clause_arena_t *arena, clause_ref_t ref, size_t size) {
+    if (!arena) return;
+    clause_t *clause = clause_arena_get(arena, ref);
+    if (size >= clause->size) return;
+    arena->wasted += clause_arena_words(clause->size) - clause_arena_words(size);
+    clause->size = (uint32_t)size;
+}
+
+/**
+ * @brief Move uma cláusula viva para outra arena durante a coleta
+ * @param from Arena atual
+ * @param to Nova arena, com espaço já reservado (clause_arena_reserve)
+ * @param ref Referência na arena atual
+ * @return Referência na nova arena
+ * 
+ * A primeira chamada copia a cláusula e deixa na cópia antiga a marca
+ * relocated com a nova referência em literals[0]; as seguintes, vindas de
+ * outras listas que apontam para a mesma cláusula, só leem esse endereço.
+ */
+clause_ref_t clause_arena_relocate(clause_arena_t *from, clause_arena_t *to, clause_ref_t ref) {
+    clause_t *clause = clause_arena_get(from, ref);
+    if (clause->relocated) return (clause_ref_t)clause->literals[0];
+    
+    size_t words = clause_arena_words(clause->size);
+    if (!clause_arena_reserve(to, words)) return CLAUSE_REF_UNDEF;
+    
+    clause_ref_t new_ref = (clause_ref_t)to->size;
+    memcpy(to->memory + new_ref, from->memory + ref, words * sizeof(uint32_t));
+    to->size += words;
+    
+    clause->relocated = true;
+    clause->literals[0] = (literal_t)new_ref;
+    return new_ref;
+}
+
+void clause_arena_dispose(clause_arena_t *arena) {
+    if (!arena) return;
+    free(arena->memory);
+    arena->memory = NULL;
+    arena->size = 0;
+    arena->capacity = 0;
+    arena->wasted = 0;
+}
+
+/* ========== Funções para Listas de Referências ========== */
+
+bool clause_ref_list_push(clause_ref_list_t *list, clause_ref_t ref) {
+    if (!list) return false;
+    
+    /* Expandir array se necessário */
+    if (list->count >= list->capacity) {
+        size_t new_capacity = list->capacity > 0 ? list->capacity * 2 : 4;
+        clause_ref_t *new_refs = realloc(list->refs, new_capacity * sizeof(clause_ref_t));
+        if (!new_refs) return false;
+        
+        list->refs = new_refs;
+        list->capacity = new_capacity;
     }
+    
+    list->refs[list->count++] = ref;
+    return true;
 }
 
-void clause_list_dispose_contents(clause_list_t *list) {
+void clause_ref_list_dispose(clause_ref_list_t *list) {
     if (!list) return;
-    for (size_t i = 0; i < list->count; i++) {
-        free(list->clauses[i].literals);
-        list->clauses[i].literals = NULL;
-        list->clauses[i].size = 0;
-        list->clauses[i].capacity = 0;
-    }
-    free(list->clauses);
-    list->clauses = NULL;
+    free(list->refs);
+    list->refs = NULL;
     list->count = 0;
     list->capacity = 0;
 }
 
-bool clause_list_add(clause_list_t *list, clause_t *clause) {
-    if (!list || !clause) return false;
+/* ========== Funções para Listas de Observação ========== */
+
+/**
+ * @brief Adiciona uma cláusula à lista de observação de um literal
+ * @param list Lista de observação do literal
+ * @param clause Referência da cláusula observadora
+ * @param blocker Outro literal da cláusula, usado para pular cláusulas satisfeitas
+ * @return true se adicionou, false em falha de alocação
+ */
+bool watch_list_push(watch_list_t *list, clause_ref_t clause, literal_t blocker) {
+    if (!list) return false;
     
     /* Expandir array se necessário */
-    if (list->count >= list->capacity) {
-        size_t new_capacity = list->capacity * 2;
-        clause_t *new_clauses = realloc(list->clauses, new_capacity * sizeof(clause_t));
-        if (!new_clauses) return false;
+    if (list->size >= list->capacity) {
+        size_t new_capacity = list->capacity > 0 ? list->capacity * 2 : 4;
+        watcher_t *new_watchers = realloc(list->watchers, new_capacity * sizeof(watcher_t));
+        if (!new_watchers) return false;
         
-        list->clauses = new_clauses;
+        list->watchers = new_watchers;
         list->capacity = new_capacity;
     }
     
-    /* Copiar a cláusula para a lista */
-    list->clauses[list->count] = *clause;
-    list->count++;
-    
+    list->watchers[list->size].clause = clause;
+    list->watchers[list->size].blocker = blocker;
+    list->size++;
     return true;
 }
 
-void clause_list_clear(clause_list_t *list) {
-    if (list) {
-        for (size_t i = 0; i < list->count; i++) {
-            free(list->clauses[i].literals);
+void watch_list_dispose(watch_list_t *list) {
+    if (!list) return;
+    free(list->watchers);
+    list->watchers = NULL;
+    list->size = 0;
+    list->capacity = 0;
+}
+
+/* ========== Funções para o Heap de Variáveis ========== */
+
+/**
+ * @brief Cria um heap de variáveis vazio
+ * @param num_variables Maior variável que pode ser inserida
+ * @param scores Array [1..num_variables] consultado a cada comparação
+ * @return Ponteiro para o heap ou NULL em caso de erro
+ * 
+ * O heap não copia os scores: quem aumenta um score deve chamar
+ * var_heap_increase() para restaurar a ordem.
+ */
+var_heap_t* var_heap_create(variable_t num_variables, const double *scores) {
+    var_heap_t *heap = malloc(sizeof(var_heap_t));
+    if (!heap) return NULL;
+    
+    heap->heap = malloc(((size_t)num_variables + 1) * sizeof(variable_t));
+    heap->positions = malloc(((size_t)num_variables + 1) * sizeof(size_t));
+    if (!heap->heap || !heap->positions) {
+        free(heap->heap);
+        free(heap->positions);
+        free(heap);
+        return NULL;
+    }
+    
+    for (variable_t var = 0; var <= num_variables; var++) {
+        heap->positions[var] = VAR_HEAP_ABSENT;
+    }
+    heap->size = 0;
+    heap->scores = scores;
+    
+    return heap;
+}
+
+void var_heap_destroy(var_heap_t *heap) {
+    if (heap) {
+        free(heap->heap);
+        free(heap->positions);
+        free(heap);
+    }
+}
+
+bool var_heap_contains(const var_heap_t *heap, variable_t var) {
+    return heap->positions[var] != VAR_HEAP_ABSENT;
+}
+
+/* Sobe a variável na posição i enquanto for maior que o pai */
+static void var_heap_sift_up(var_heap_t *heap, size_t i) {
+    variable_t var = heap->heap[i];
+    double score = heap->scores[var];
+    
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (heap->scores[heap->heap[parent]] >= score) break;
+        heap->heap[i] = heap->heap[parent];
+        heap->positions[heap->heap[i]] = i;
+        i = parent;
+    }
+    
+    heap->heap[i] = var;
+    heap->positions[var] = i;
+}
+
+/* Desce a variável na posição i enquanto algum filho for maior */
+static void var_heap_sift_down(var_heap_t *heap, size_t i) {
+    variable_t var = heap->heap[i];
+    double score = heap->scores[var];
+    
+    while (2 * i + 1 < heap->size) {
+        size_t child = 2 * i + 1;
+        if (child + 1 < heap->size &&
+            heap->scores[heap->heap[child + 1]] > heap->scores[heap->heap[child]]) {
+            child++;
         }
-        list->count = 0;
+        if (heap->scores[heap->heap[child]] <= score) break;
+        heap->heap[i] = heap->heap[child];
+        heap->positions[heap->heap[i]] = i;
+        i = child;
+    }
+    
+    heap->heap[i] = var;
+    heap->positions[var] = i;
+}
+
+void var_heap_insert(var_heap_t *heap, variable_t var) {
+    if (var_heap_contains(heap, var)) return;
+    
+    heap->heap[heap->size] = var;
+    heap->positions[var] = heap->size;
+    heap->size++;
+    var_heap_sift_up(heap, heap->size - 1);
+}
+
+void var_heap_increase(var_heap_t *heap, variable_t var) {
+    if (var_heap_contains(heap, var)) {
+        var_heap_sift_up(heap, heap->positions[var]);
+    }
+}
+
+/**
+ * @brief Remove e devolve a variável de maior score (0 se o heap está vazio)
+ */
+variable_t var_heap_pop(var_heap_t *heap) {
+    if (heap->size == 0) return 0;
+    
+    variable_t top = heap->heap[0];
+    heap->positions[top] = VAR_HEAP_ABSENT;
+    heap->size--;
+    
+    if (heap->size > 0) {
+        heap->heap[0] = heap->heap[heap->size];
+        heap->positions[heap->heap[0]] = 0;
+        var_heap_sift_down(heap, 0);
     }
+    
+    return top;
 }
 
 /* ========== Funções para Fórmula CNF ========== */
@@ -268,8 +555,12 @@ cnf_formula_t* cnf_create(variable_t num_variables) {
     cnf_formula_t *cnf = malloc(sizeof(cnf_formula_t));
     if (!cnf) return NULL;
     
-    /* Inicializar lista de cláusulas */
-    cnf->clauses.clauses = NULL;
+    /* Arena e lista de cláusulas começam vazias e crescem sob demanda */
+    cnf->arena.memory = NULL;
+    cnf->arena.size = 0;
+    cnf->arena.capacity = 0;
+    cnf->arena.wasted = 0;
+    cnf->clauses.refs = NULL;
     cnf->clauses.count = 0;
     cnf->clauses.capacity = 0;
     
@@ -290,9 +581,12 @@ cnf_formula_t* cnf_create(variable_t num_variables) {
     
     cnf->num_variables = num_variables;
     cnf->satisfied_clauses = 0;
+    cnf->learnt_count = 0;
     
     /* Listas de ocorrências (serão inicializadas quando necessário) */
+    cnf->positive_offsets = NULL;
     cnf->positive_occurrences = NULL;
+    cnf->negative_offsets = NULL;
     cnf->negative_occurrences = NULL;
     
     return cnf;
@@ -300,66 +594,155 @@ cnf_formula_t* cnf_create(variable_t num_variables) {
 
 void cnf_destroy(cnf_formula_t *cnf) {
     if (cnf) {
-        /* cnf->clauses é embutido dentro de cnf, então não dar free na struct, apenas no conteúdo */
-        clause_list_dispose_contents(&cnf->clauses);
+        /* Arena e lista são embutidas dentro de cnf: liberar apenas o conteúdo */
+        clause_arena_dispose(&cnf->arena);
+        clause_ref_list_dispose(&cnf->clauses);
         free(cnf->assignment);
         free(cnf->variable_used);
         
-        /* Liberar listas de ocorrências se alocadas */
-        if (cnf->positive_occurrences) {
-            for (variable_t i = 1; i <= cnf->num_variables; i++) {
-                clause_list_destroy(cnf->positive_occurrences[i]);
-            }
-            free(cnf->positive_occurrences);
-        }
-        
-        if (cnf->negative_occurrences) {
-            for (variable_t i = 1; i <= cnf->num_variables; i++) {
-                clause_list_destroy(cnf->negative_occurrences[i]);
-            }
-            free(cnf->negative_occurrences);
-        }
+        cnf_free_occurrence_lists(cnf);
         
         free(cnf);
     }
 }
 
-bool cnf_add_clause(cnf_formula_t *cnf, clause_t *clause) {
-    if (!cnf || !clause) return false;
+/**
+ * @brief Copia uma cláusula para a arena da fórmula e registra sua referência
+ * @param cnf Fórmula CNF
+ * @param literals Literais da cláusula (o chamador mantém a posse do array),
+ *        já normalizados: sem duplicatas nem tautologias (clause_normalize)
+ * @param size Número de literais
+ * @param learnt Se a cláusula é aprendida
+ * @return Referência da cláusula ou CLAUSE_REF_UNDEF em falha de alocação
+ *
+ * A cópia não verifica os literais: a propagação e as simplificações
+ * supõem cláusulas normalizadas. Entradas externas passam pelo
+ * clause_normalizer_t do parser (texto e binário); cláusulas aprendidas,
+ * resolventes e hiper-binárias já nascem normalizadas.
+ */
+clause_ref_t cnf_add_clause_literals(cnf_formula_t *cnf, const literal_t *literals, size_t size,
+                                     bool learnt) {
+    if (!cnf) return CLAUSE_REF_UNDEF;
     
-    /* Inicializar lista de cláusulas se necessário */
-    if (cnf->clauses.clauses == NULL) {
-        cnf->clauses.capacity = 16;
-        cnf->clauses.clauses = malloc(cnf->clauses.capacity * sizeof(clause_t));
-        if (!cnf->clauses.clauses) return false;
-        cnf->clauses.count = 0;
+    clause_ref_t ref = clause_arena_alloc(&cnf->arena, literals, size, learnt);
+    if (ref == CLAUSE_REF_UNDEF) return CLAUSE_REF_UNDEF;
+    if (!clause_ref_list_push(&cnf->clauses, ref)) {
+        clause_arena_free(&cnf->arena, ref);
+        return CLAUSE_REF_UNDEF;
     }
     
     /* Marcar variáveis como usadas */
-    for (size_t i = 0; i < clause->size; i++) {
-        variable_t var = literal_variable(clause->literals[i]);
+    for (size_t i = 0; i < size; i++) {
+        variable_t var = literal_variable(literals[i]);
         if (var <= cnf->num_variables) {
             cnf->variable_used[var] = true;
         }
     }
     
-    bool ok = clause_list_add(&cnf->clauses, clause);
-    /* Transferência de propriedade: após copiar para a lista,
-       liberar apenas o contêiner original (não os literais) */
-    if (ok) {
-        free(clause);
-    } else {
-        /* Falhou ao adicionar: destruir completamente a cláusula alocada */
-        clause_destroy(clause);
+    if (learnt) {
+        cnf->learnt_count++;
+    }
+    return ref;
+}
+
+/**
+ * @brief Acrescenta ao fim de uma fórmula todas as cláusulas de outra
+ * @param cnf Fórmula de destino
+ * @param other Fórmula de origem (não é alterada)
+ * @return false se other tem mais variáveis que cnf ou falta memória
+ * 
+ * A arena de origem é copiada em bloco e as referências são deslocadas
+ * pela posição onde o bloco começa, preservando a ordem das cláusulas.
+ */
+bool cnf_append_formula(cnf_formula_t *cnf, const cnf_formula_t *other) {
+    if (!cnf || !other || other->num_variables > cnf->num_variables) return false;
+    if (!clause_arena_reserve(&cnf->arena, other->arena.size)) return false;
+    
+    clause_ref_t base = (clause_ref_t)cnf->arena.size;
+    if (other->arena.size > 0) {
+        memcpy(cnf->arena.memory + base, other->arena.memory,
+               other->arena.size * sizeof(uint32_t));
+    }
+    cnf->arena.size += other->arena.size;
+    cnf->arena.wasted += other->arena.wasted;
+    
+    for (size_t i = 0; i < other->clauses.count; i++) {
+        if (!clause_ref_list_push(&cnf->clauses, base + other->clauses.refs[i])) return false;
+    }
+    for (variable_t var = 1; var <= other->num_variables; var++) {
+        cnf->variable_used[var] |= other->variable_used[var];
+    }
+    cnf->learnt_count += other->learnt_count;
+    return true;
+}
+
+/**
+ * @brief Remove uma cláusula da fórmula
+ * @param cnf Fórmula CNF
+ * @param ref Cláusula a remover
+ * 
+ * Apenas marca a cláusula na arena: quem percorre cnf->clauses retira a
+ * referência da lista, e listas de ocorrências e de observação são limpas
+ * na próxima coleta.
+ */
+void cnf_delete_clause(cnf_formula_t *cnf, clause_ref_t ref) {
+    if (!cnf) return;
+    clause_t *clause = cnf_clause(cnf, ref);
+    if (clause->deleted) return;
+    if (clause->learnt) {
+        cnf->learnt_count--;
+    }
+    clause_arena_free(&cnf->arena, ref);
+}
+
+/**
+ * @brief Move as cláusulas vivas da fórmula para uma nova arena
+ * @param cnf Fórmula CNF
+ * @param to Nova arena, com espaço reservado para todas as cláusulas vivas
+ * 
+ * As cláusulas são copiadas na ordem de cnf->clauses, e a lista e as
+ * listas de ocorrências passam a apontar para a nova arena, sem as
+ * removidas. A arena antiga continua válida (com os endereços de
+ * redirecionamento) até o chamador corrigir as próprias referências e
+ * trocá-la pela nova.
+ */
+void cnf_relocate_clauses(cnf_formula_t *cnf, clause_arena_t *to) {
+    if (!cnf || !to) return;
+    
+    size_t kept = 0;
+    for (size_t i = 0; i < cnf->clauses.count; i++) {
+        clause_ref_t ref = cnf->clauses.refs[i];
+        if (cnf_clause(cnf, ref)->deleted) continue;
+        cnf->clauses.refs[kept++] = clause_arena_relocate(&cnf->arena, to, ref);
+    }
+    cnf->clauses.count = kept;
+    
+    /* Compactar cada polaridade do CSR em uma passada, mantendo a ordem */
+    if (!cnf->positive_offsets) return;
+    size_t *offsets_by_polarity[2] = { cnf->positive_offsets, cnf->negative_offsets };
+    clause_ref_t *refs_by_polarity[2] = { cnf->positive_occurrences, cnf->negative_occurrences };
+    for (int p = 0; p < 2; p++) {
+        size_t *offsets = offsets_by_polarity[p];
+        clause_ref_t *refs = refs_by_polarity[p];
+        size_t write = 0;
+        for (variable_t var = 1; var <= cnf->num_variables; var++) {
+            size_t begin = offsets[var];
+            size_t end = offsets[var + 1];
+            offsets[var] = write;
+            for (size_t k = begin; k < end; k++) {
+                if (cnf_clause(cnf, refs[k])->deleted) continue;
+                refs[write++] = clause_arena_relocate(&cnf->arena, to, refs[k]);
+            }
+        }
+        offsets[cnf->num_variables + 1] = write;
     }
-    return ok;
 }
 
 bool cnf_is_satisfied(const cnf_formula_t *cnf) {
     if (!cnf) return false;
     
     for (size_t i = 0; i < cnf->clauses.count; i++) {
-        if (!clause_is_satisfied(&cnf->clauses.clauses[i], cnf->assignment)) {
+        if (!clause_is_satisfied(cnf_clause(cnf, cnf->clauses.refs[i]), cnf->assignment)) {
             return false;
         }
     }
@@ -371,7 +754,7 @@ bool cnf_has_conflict(const cnf_formula_t *cnf) {
     if (!cnf) return false;
     
     for (size_t i = 0; i < cnf->clauses.count; i++) {
-        if (clause_is_conflicting(&cnf->clauses.clauses[i], cnf->assignment)) {
+        if (clause_is_conflicting(cnf_clause(cnf, cnf->clauses.refs[i]), cnf->assignment)) {
             return true;
         }
     }
@@ -385,17 +768,93 @@ void cnf_update_caches(cnf_formula_t *cnf) {
     cnf->satisfied_clauses = 0;
     
     for (size_t i = 0; i < cnf->clauses.count; i++) {
-        clause_t *clause = &cnf->clauses.clauses[i];
-        
-        clause->is_satisfied = clause_is_satisfied(clause, cnf->assignment);
-        if (clause->is_satisfied) {
+        if (clause_is_satisfied(cnf_clause(cnf, cnf->clauses.refs[i]), cnf->assignment)) {
             cnf->satisfied_clauses++;
         }
-        
-        clause->is_unit = clause_is_unit(clause, cnf->assignment, &clause->unit_literal);
     }
 }
 
+/**
+ * @brief Constrói as listas de ocorrências de cada literal em formato CSR
+ * @param cnf Fórmula CNF
+ * @return false em falha de alocação
+ * 
+ * Duas passadas sobre as cláusulas não aprendidas: a primeira conta as
+ * ocorrências de cada literal e gera os offsets por soma de prefixos; a
+ * segunda preenche os índices. Cada polaridade usa apenas dois arrays
+ * contíguos, sem copiar cláusulas. Listas anteriores são descartadas.
+ */
+bool cnf_build_occurrence_lists(cnf_formula_t *cnf) {
+    if (!cnf) return false;
+    
+    cnf_free_occurrence_lists(cnf);
+    
+    size_t num_offsets = (size_t)cnf->num_variables + 2;
+    cnf->positive_offsets = calloc(num_offsets, sizeof(size_t));
+    cnf->negative_offsets = calloc(num_offsets, sizeof(size_t));
+    if (!cnf->positive_offsets || !cnf->negative_offsets) {
+        cnf_free_occurrence_lists(cnf);
+        return false;
+    }
+    
+    /* Contagem deslocada de uma posição: offsets[x + 1] += ocorrências de x */
+    for (size_t i = 0; i < cnf->clauses.count; i++) {
+        const clause_t *clause = cnf_clause(cnf, cnf->clauses.refs[i]);
+        if (clause->learnt) continue;
+        for (size_t k = 0; k < clause->size; k++) {
+            literal_t lit = clause->literals[k];
+            size_t *offsets = lit > 0 ? cnf->positive_offsets : cnf->negative_offsets;
+            offsets[literal_variable(lit) + 1]++;
+        }
+    }
+    for (size_t v = 1; v < num_offsets; v++) {
+        cnf->positive_offsets[v] += cnf->positive_offsets[v - 1];
+        cnf->negative_offsets[v] += cnf->negative_offsets[v - 1];
+    }
+    
+    size_t positive_total = cnf->positive_offsets[num_offsets - 1];
+    size_t negative_total = cnf->negative_offsets[num_offsets - 1];
+    cnf->positive_occurrences = malloc((positive_total + 1) * sizeof(clause_ref_t));
+    cnf->negative_occurrences = malloc((negative_total + 1) * sizeof(clause_ref_t));
+    size_t *positive_fill = malloc(num_offsets * sizeof(size_t));
+    size_t *negative_fill = malloc(num_offsets * sizeof(size_t));
+    if (!cnf->positive_occurrences || !cnf->negative_occurrences ||
+        !positive_fill || !negative_fill) {
+        free(positive_fill);
+        free(negative_fill);
+        cnf_free_occurrence_lists(cnf);
+        return false;
+    }
+    memcpy(positive_fill, cnf->positive_offsets, num_offsets * sizeof(size_t));
+    memcpy(negative_fill, cnf->negative_offsets, num_offsets * sizeof(size_t));
+    
+    for (size_t i = 0; i < cnf->clauses.count; i++) {
+        const clause_t *clause = cnf_clause(cnf, cnf->clauses.refs[i]);
+        if (clause->learnt) continue;
+        for (size_t k = 0; k < clause->size; k++) {
+            literal_t lit = clause->literals[k];
+            variable_t var = literal_variable(lit);
+            if (lit > 0) {
+                cnf->positive_occurrences[positive_fill[var]++] = cnf->clauses.refs[i];
+            } else {
+                cnf->negative_occurrences[negative_fill[var]++] = cnf->clauses.refs[i];
+            }
+        }
+    }
+    
+    free(positive_fill);
+    free(negative_fill);
+    return true;
+}
+
+void cnf_free_occurrence_lists(cnf_formula_t *cnf) {
+    if (!cnf) return;
+    SAFE_FREE(cnf->positive_offsets);
+    SAFE_FREE(cnf->positive_occurrences);
+    SAFE_FREE(cnf->negative_offsets);
+    SAFE_FREE(cnf->negative_occurrences);
+}
+
 /* ========== Funções para Pilha de Atribuições ========== */
 
 assignment_stack_t* assignment_stack_create(size_t initial_capacity) {
@@ -423,7 +882,7 @@ void assignment_stack_destroy(assignment_stack_t *stack) {
 }
 
 bool assignment_stack_push(assignment_stack_t *stack, variable_t var, 
-                          var_assignment_t value, bool is_decision) {
+                          var_assignment_t value, bool is_decision, clause_ref_t reason) {
     if (!stack) return false;
     
     /* Expandir stack se necessário */
@@ -446,6 +905,7 @@ bool assignment_stack_push(assignment_stack_t *stack, variable_t var,
     entry->value = value;
     entry->decision_level = stack->decision_level;
     entry->is_decision = is_decision;
+    entry->reason = reason;
     
     return true;
 }
@@ -491,7 +951,7 @@ void cnf_print_stats(const cnf_formula_t *cnf) {
     
     printf("=== Estatísticas da Fórmula CNF ===\n");
     printf("Variáveis: %d\n", cnf->num_variables);
-    printf("Cláusulas: %zu\n", cnf->clauses.count);
+    printf("Cláusulas: %zu\n", cnf->clauses.count - cnf->learnt_count);
     printf("Cláusulas satisfeitas: %zu\n", cnf->satisfied_clauses);
     
     /* Contar variáveis usadas */
@@ -507,7 +967,8 @@ void cnf_print_formula(const cnf_formula_t *cnf) {
     
     printf("=== Fórmula CNF ===\n");
     for (size_t i = 0; i < cnf->clauses.count; i++) {
-        const clause_t *clause = &cnf->clauses.clauses[i];
+        const clause_t *clause = cnf_clause(cnf, cnf->clauses.refs[i]);
+        if (clause->learnt) continue;
         printf("Cláusula %zu: (", i + 1);
         
         for (size_t j = 0; j < clause->size; j++) {
@@ -519,8 +980,12 @@ void cnf_print_formula(const cnf_formula_t *cnf) {
         }
         
         printf(")");
-        if (clause->is_satisfied) printf(" [SAT]");
-        if (clause->is_unit) printf(" [UNIT: %d]", clause->unit_literal);
+        literal_t unit_literal;
+        if (clause_is_satisfied(clause, cnf->assignment)) {
+            printf(" [SAT]");
+        } else if (clause_is_unit(clause, cnf->assignment, &unit_literal)) {
+            printf(" [UNIT: %d]", unit_literal);
+        }
         printf("\n");
     }
 }
@@ -529,7 +994,7 @@ bool cnf_validate_assignment(const cnf_formula_t *cnf) {
     if (!cnf) return false;
     
     for (size_t i = 0; i < cnf->clauses.count; i++) {
-        if (!clause_is_satisfied(&cnf->clauses.clauses[i], cnf->assignment)) {
+        if (!clause_is_satisfied(cnf_clause(cnf, cnf->clauses.refs[i]), cnf->assignment)) {
             printf("Cláusula %zu não satisfeita!\n", i + 1);
             return false;
         }
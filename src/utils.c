@@ -86,6 +86,37 @@ void stats_print(const solver_stats_t *stats) {
     printf("Conflitos:             %llu\n", (unsigned long long)stats->conflicts);
     printf("Reinicializações:      %llu\n", (unsigned long long)stats->restarts);
     printf("Cláusulas aprendidas:  %llu\n", (unsigned long long)stats->learned_clauses);
+    if (stats->reductions > 0) {
+        printf("Reduções da base:      %llu\n", (unsigned long long)stats->reductions);
+        printf("Aprendidas removidas:  %llu\n", (unsigned long long)stats->deleted_clauses);
+        printf("Aprendidas mantidas:   %llu\n", (unsigned long long)stats->kept_clauses);
+    }
+    if (stats->subsumed_clauses > 0 || stats->strengthened_literals > 0) {
+        printf("Cláusulas subsumidas:  %llu\n", (unsigned long long)stats->subsumed_clauses);
+        printf("Literais removidos:    %llu\n", (unsigned long long)stats->strengthened_literals);
+    }
+    if (stats->failed_literals > 0 || stats->implied_literals > 0 || stats->hyper_binary > 0) {
+        printf("Literais falhos:       %llu\n", (unsigned long long)stats->failed_literals);
+        printf("Implicados comuns:     %llu\n", (unsigned long long)stats->implied_literals);
+        printf("Hiper-binárias:        %llu\n", (unsigned long long)stats->hyper_binary);
+    }
+    if (stats->substituted_vars > 0) {
+        printf("Equivalências:         %llu\n", (unsigned long long)stats->substituted_vars);
+    }
+    if (stats->blocked_clauses > 0) {
+        printf("Cláusulas bloqueadas:  %llu\n", (unsigned long long)stats->blocked_clauses);
+    }
+    if (stats->eliminated_vars > 0) {
+        printf("Variáveis eliminadas:  %llu\n", (unsigned long long)stats->eliminated_vars);
+        printf("Resolventes:           %llu\n", (unsigned long long)stats->resolvents);
+    }
+    if (stats->inprocessings > 0) {
+        printf("Inprocessamentos:      %llu\n", (unsigned long long)stats->inprocessings);
+    }
+    if (stats->vivified_clauses > 0) {
+        printf("Cláusulas vivificadas: %llu\n", (unsigned long long)stats->vivified_clauses);
+        printf("Literais vivificados:  %llu\n", (unsigned long long)stats->vivified_literals);
+    }
     printf("Nível máximo:          %zu\n", stats->max_decision_level);
     printf("Tempo total:           %.6f segundos\n", stats->solve_time);
     
@@ -236,7 +267,8 @@ bool is_valid_variable(int var, int max_variables) {
 }
 
 bool is_valid_literal(int lit, int max_variables) {
-    if (lit == 0) return false;
+    /* Rejeitar antes de negar: -INT_MIN não é representável */
+    if (lit == 0 || lit < -max_variables) return false;
     int var = lit > 0 ? lit : -lit;
     return is_valid_variable(var, max_variables);
 }